@@ -2,12 +2,21 @@
 #include "catalog/schema.h"
 #include "catalog/table_metadata.h"
 #include "catalog/index_metadata.h"
+#include "common/config.h"
 #include <unordered_map>
 #include <memory>
 #include <mutex>
 
 namespace mokshith {
 
+class LogManager;
+
+// Physical layout of a table's heap pages
+enum class StorageLayout {
+    ROW,  // TableHeap, slotted pages of whole tuples
+    PAX   // PaxTableHeap, per-column minipages inside each page
+};
+
 class Catalog {
 public:
     Catalog(BufferPool* buffer_pool);
@@ -16,7 +25,8 @@ public:
     // Table operations
     bool CreateTable(txn_id_t txn_id,
                     const std::string& table_name,
-                    const Schema& schema);
+                    const Schema& schema,
+                    StorageLayout layout = StorageLayout::ROW);
     
     bool DropTable(txn_id_t txn_id,
                   const std::string& table_name);
@@ -24,12 +34,15 @@ public:
     TableMetadata* GetTable(const std::string& table_name);
     TableMetadata* GetTable(oid_t table_oid);
     
-    // Index operations
+    // Index operations. On a non-empty table the index is bulk built:
+    // the heap is scanned once, (key, RID) pairs are sorted with an
+    // ExternalSorter and a B+Tree is loaded bottom-up at fill_factor.
     bool CreateIndex(txn_id_t txn_id,
                     const std::string& index_name,
                     const std::string& table_name,
                     const std::vector<uint32_t>& key_columns,
-                    IndexType index_type);
+                    IndexType index_type,
+                    double fill_factor = INDEX_FILL_FACTOR);
     
     bool DropIndex(txn_id_t txn_id,
                   const std::string& index_name);
@@ -39,8 +52,15 @@ public:
     
     std::vector<IndexMetadata*> GetTableIndexes(const std::string& table_name);
     
+    // WAL for minimally logged index builds; null disables logging
+    void SetLogManager(LogManager* log_manager) { log_manager_ = log_manager; }
+    
 private:
     BufferPool* buffer_pool_;
+    LogManager* log_manager_ = nullptr;
+    
+    bool BuildIndex(txn_id_t txn_id, TableMetadata* table, IndexMetadata* index,
+                    double fill_factor);
     
     // Tables
     std::unordered_map<oid_t, std::unique_ptr<TableMetadata>> tables_;
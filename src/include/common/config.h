@@ -0,0 +1,42 @@
+#pragma once
+#include "common/types.h"
+
+namespace mokshith {
+
+// Buffer pool and I/O
+static constexpr size_t BUFFER_POOL_SIZE = 100;
+static constexpr size_t BUFFER_POOL_SHARDS = 8;  // 1 = single latch
+static constexpr size_t READ_AHEAD_PAGES = 16;   // max read-ahead window for sequential scans
+static constexpr size_t SCAN_RING_SIZE = 32;     // frames per pool reserved for sequential scans
+static constexpr unsigned IO_URING_QUEUE_DEPTH = 64;
+
+// Pages per morsel in parallel scans: large enough to amortize
+// scheduling, small enough to balance skew across workers
+static constexpr size_t MORSEL_PAGES = 64;
+
+// Default fraction of each B+Tree node filled by CREATE INDEX; the rest
+// absorbs later inserts without immediate splits
+static constexpr double INDEX_FILL_FACTOR = 0.9;
+
+// Row locks one transaction may hold on a table before LockManager
+// escalates them to a single table lock
+static constexpr size_t LOCK_ESCALATION_THRESHOLD = 5000;
+
+// WAL: size of each of the two log buffers, and how long the flush
+// thread lingers after the first commit to batch others into its fsync
+static constexpr size_t LOG_BUFFER_SIZE = 4 * 1024 * 1024;
+static constexpr uint64_t GROUP_COMMIT_WINDOW_US = 200;
+
+// Threads replaying the log in parallel during restart redo
+static constexpr size_t RECOVERY_REDO_WORKERS = 8;
+
+// Per-session tunables, changed with SET <name> = <value>
+struct SessionSettings {
+    // Degree of parallelism for morsel-driven plans; 1 = serial plans
+    size_t max_parallel_workers = 1;
+    size_t morsel_pages = MORSEL_PAGES;
+    // Memory per join / aggregation / sort operator before it spills
+    size_t work_mem = 64 * 1024 * 1024;
+};
+
+} // namespace mokshith
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+namespace mokshith {
+
+// Lock-free latency histogram with log-linear buckets: values below
+// LINEAR_LIMIT microseconds get one bucket each, larger values 16
+// buckets per power of two, so percentiles are within ~6% up to hours.
+// Record() is a single relaxed fetch_add; readers see a consistent
+// enough snapshot for reporting.
+class LatencyHistogram {
+public:
+    static constexpr uint32_t LINEAR_LIMIT = 16;
+    static constexpr uint32_t SUB_BUCKETS = 16;
+    static constexpr uint32_t NUM_BUCKETS = LINEAR_LIMIT + (64 - 4) * SUB_BUCKETS;
+
+    LatencyHistogram() { Reset(); }
+
+    void Record(uint64_t micros) {
+        buckets_[BucketOf(micros)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(micros, std::memory_order_relaxed);
+        uint64_t max = max_.load(std::memory_order_relaxed);
+        while (micros > max && !max_.compare_exchange_weak(max, micros, std::memory_order_relaxed)) {}
+    }
+
+    uint64_t Count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t Max() const { return max_.load(std::memory_order_relaxed); }
+    double Mean() const {
+        uint64_t count = Count();
+        return count == 0 ? 0.0 : static_cast<double>(sum_.load(std::memory_order_relaxed)) / count;
+    }
+
+    // Upper bound of the bucket holding the p-th percentile (0 < p <= 100)
+    uint64_t Percentile(double p) const {
+        uint64_t count = Count();
+        if (count == 0) return 0;
+        uint64_t rank = static_cast<uint64_t>(p / 100.0 * count + 0.5);
+        rank = std::max<uint64_t>(rank, 1);
+        uint64_t seen = 0;
+        for (uint32_t bucket = 0; bucket < NUM_BUCKETS; ++bucket) {
+            seen += buckets_[bucket].load(std::memory_order_relaxed);
+            if (seen >= rank) return std::min(BucketUpperBound(bucket), Max());
+        }
+        return Max();
+    }
+
+    void Reset() {
+        for (auto& bucket : buckets_) bucket.store(0, std::memory_order_relaxed);
+        count_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static uint32_t BucketOf(uint64_t value) {
+        if (value < LINEAR_LIMIT) return static_cast<uint32_t>(value);
+        uint32_t exponent = 63 - static_cast<uint32_t>(__builtin_clzll(value));  // >= 4
+        uint32_t sub = static_cast<uint32_t>((value >> (exponent - 4)) & (SUB_BUCKETS - 1));
+        return LINEAR_LIMIT + (exponent - 4) * SUB_BUCKETS + sub;
+    }
+
+    static uint64_t BucketUpperBound(uint32_t bucket) {
+        if (bucket < LINEAR_LIMIT) return bucket;
+        uint32_t exponent = (bucket - LINEAR_LIMIT) / SUB_BUCKETS + 4;
+        uint64_t sub = (bucket - LINEAR_LIMIT) % SUB_BUCKETS;
+        uint64_t width = uint64_t(1) << (exponent - 4);
+        return (uint64_t(1) << exponent) + (sub + 1) * width - 1;
+    }
+
+    std::atomic<uint64_t> buckets_[NUM_BUCKETS];
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> sum_;
+    std::atomic<uint64_t> max_;
+};
+
+} // namespace mokshith
\ No newline at end of file
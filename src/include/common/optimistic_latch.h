@@ -0,0 +1,83 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace mokshith {
+
+// Version latch for optimistic lock coupling.
+//
+// Readers take no lock: they remember the version, read, and validate
+// that the version is unchanged afterwards; on a mismatch they restart.
+// Writers set the locked bit with a CAS from the version they read, so a
+// reader can upgrade to a writer only if nothing changed in between.
+// Unlocking bumps the version, which invalidates every concurrent read.
+//
+// Version word: | counter ... | locked (bit 1) | obsolete (bit 0) |
+class OptimisticLatch {
+public:
+    static constexpr uint64_t OBSOLETE_BIT = 1;
+    static constexpr uint64_t LOCKED_BIT = 2;
+
+    OptimisticLatch() : version_(4) {}
+
+    // Spins while a writer holds the latch; sets `restart` if the node
+    // was deleted
+    uint64_t ReadLockOrRestart(bool& restart) const {
+        uint64_t version = AwaitUnlocked();
+        if (version & OBSOLETE_BIT) restart = true;
+        return version;
+    }
+
+    // Validates an optimistic read; also used to release a read lock
+    void CheckOrRestart(uint64_t version, bool& restart) const {
+        if (version_.load(std::memory_order_acquire) != version) restart = true;
+    }
+
+    void UpgradeToWriteLockOrRestart(uint64_t& version, bool& restart) {
+        if (version_.compare_exchange_strong(version, version + LOCKED_BIT,
+                                             std::memory_order_acquire)) {
+            version += LOCKED_BIT;
+        } else {
+            restart = true;
+        }
+    }
+
+    void WriteLockOrRestart(bool& restart) {
+        uint64_t version = ReadLockOrRestart(restart);
+        if (restart) return;
+        UpgradeToWriteLockOrRestart(version, restart);
+    }
+
+    void WriteUnlock() { version_.fetch_add(LOCKED_BIT, std::memory_order_release); }
+    // Releases the latch and marks the node deleted (merged away)
+    void WriteUnlockObsolete() {
+        version_.fetch_add(LOCKED_BIT + OBSOLETE_BIT, std::memory_order_release);
+    }
+
+    // The frame is being reassigned to another page: clears the obsolete
+    // bit left by a merged-away node. The counter still moves forward, so
+    // readers holding a version from the old page fail validation.
+    // Caller has exclusive use of the frame.
+    void Reset() {
+        uint64_t version = version_.load(std::memory_order_relaxed);
+        version_.store((version & ~(LOCKED_BIT | OBSOLETE_BIT)) + 4, std::memory_order_release);
+    }
+
+    bool IsLocked() const { return version_.load(std::memory_order_relaxed) & LOCKED_BIT; }
+    uint64_t GetVersion() const { return version_.load(std::memory_order_acquire); }
+
+private:
+    uint64_t AwaitUnlocked() const {
+        uint64_t version = version_.load(std::memory_order_acquire);
+        for (int spins = 0; version & LOCKED_BIT; ++spins) {
+            if (spins > 64) std::this_thread::yield();
+            version = version_.load(std::memory_order_acquire);
+        }
+        return version;
+    }
+
+    std::atomic<uint64_t> version_;
+};
+
+} // namespace mokshith
\ No newline at end of file
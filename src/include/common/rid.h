@@ -0,0 +1,41 @@
+#pragma once
+#include "common/types.h"
+#include <functional>
+
+namespace mokshith {
+
+// Record id of a heap tuple: page and slot. PAX tables hand out logical
+// RIDs instead, see PaxTableHeap.
+class RID {
+public:
+    RID() : page_id_(INVALID_PAGE_ID), slot_num_(0) {}
+    RID(page_id_t page_id, uint32_t slot_num) : page_id_(page_id), slot_num_(slot_num) {}
+
+    page_id_t GetPageId() const { return page_id_; }
+    uint32_t GetSlotNum() const { return slot_num_; }
+    void Set(page_id_t page_id, uint32_t slot_num) {
+        page_id_ = page_id;
+        slot_num_ = slot_num;
+    }
+
+    bool operator==(const RID& other) const {
+        return page_id_ == other.page_id_ && slot_num_ == other.slot_num_;
+    }
+    bool operator!=(const RID& other) const { return !(*this == other); }
+
+private:
+    page_id_t page_id_;
+    uint32_t slot_num_;
+};
+
+} // namespace mokshith
+
+namespace std {
+template <>
+struct hash<mokshith::RID> {
+    size_t operator()(const mokshith::RID& rid) const {
+        uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(rid.GetPageId())) << 32) | rid.GetSlotNum();
+        return static_cast<size_t>(key * 0x9E3779B97F4A7C15ull);
+    }
+};
+} // namespace std
\ No newline at end of file
@@ -6,7 +6,17 @@ namespace mokshith {
     using page_id_t = int32_t;
     using frame_id_t = int32_t;
     using txn_id_t = int32_t;
+    using oid_t = uint32_t;        // catalog object ids: tables, indexes
+    using lsn_t = int32_t;
+    using timestamp_t = uint64_t;  // MVCC read / commit timestamps
+    
+    static constexpr page_id_t INVALID_PAGE_ID = -1;
+    static constexpr lsn_t INVALID_LSN = -1;
     
     static constexpr size_t PAGE_SIZE = 4096;
-    static constexpr size_t BUFFER_POOL_SIZE = 100;
+    
+    // Comparison operators shared by encoded-column and vectorized filters
+    enum class CompareOp : uint8_t {
+        EQ, NE, LT, LE, GT, GE
+    };
 }
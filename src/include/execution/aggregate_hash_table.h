@@ -0,0 +1,138 @@
+#pragma once
+#include "execution/data_chunk.h"
+#include "execution/join_hash_table.h"
+#include "execution/spill.h"
+#include "planner/plan_node.h"
+#include <memory>
+#include <vector>
+
+namespace mokshith {
+
+// Fixed-size, unboxed running state of one aggregate. AVG keeps sum and
+// count; MIN/MAX start with has_value = false.
+struct AggregateState {
+    union {
+        int64_t i;
+        double f;
+    } value;
+    int64_t count;
+    bool has_value;
+};
+
+// Byte layout of a group: | hash | serialized group key | AggregateState[n] |
+// Groups are stored row-wise in arenas so a whole group is one or two
+// cache lines and can be spilled or merged as a single byte string.
+struct GroupLayout {
+    size_t key_size;          // 0 for variable-length keys (length-prefixed)
+    size_t num_aggregates;
+    size_t state_offset;
+    size_t group_size;        // fixed part
+};
+
+// Thread-local pre-aggregation table.
+//
+// A small open-addressing table (capacity chosen to stay in L2). When it
+// fills up, every group is flushed into the owning partition's overflow
+// buffer by the top RADIX bits of its hash and the table starts empty,
+// so heavy hitters stay local while rare groups pass through.
+class PreAggregationTable {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+    PreAggregationTable(const GroupLayout& layout, uint32_t radix_bits,
+                        size_t capacity = DEFAULT_CAPACITY);
+
+    // Aggregates the selected rows of a chunk; key and input columns are
+    // positions in the chunk
+    void Sink(const DataChunk& chunk,
+              const std::vector<uint32_t>& key_columns,
+              const std::vector<std::pair<AggregateType, int32_t>>& aggregates);
+
+    // Flushes the table into the per-partition buffers and hands them over
+    void Finish(std::vector<std::vector<char>>* partition_buffers);
+
+private:
+    GroupLayout layout_;
+    RadixPartitioner partitioner_;
+    JoinHashTable index_;
+    std::vector<char> groups_;
+    std::vector<std::vector<char>> partition_buffers_;
+
+    void FlushToPartitions();
+};
+
+// Merge phase: one task per radix partition combines the pre-aggregated
+// groups from every thread into a single table. If a partition's table
+// grows past its share of the memory budget, the partition's remaining
+// input is spilled and merged in a later pass with more radix bits.
+class PartitionedAggregateTable {
+public:
+    PartitionedAggregateTable(BufferPool* buffer_pool, const GroupLayout& layout,
+                              uint32_t radix_bits, size_t memory_budget);
+
+    void MergePartition(uint32_t partition, const std::vector<char>& groups);
+    // Spilled partitions are re-merged here once in-memory ones are done
+    void MergeSpilled(uint32_t partition);
+
+    bool IsSpilled(uint32_t partition) const { return spills_[partition] != nullptr; }
+
+    // Iterates final groups of one partition
+    size_t GetNumGroups(uint32_t partition) const;
+    const char* GetGroup(uint32_t partition, size_t index) const;
+
+private:
+    struct Partition {
+        JoinHashTable index;
+        std::vector<char> groups;
+    };
+
+    BufferPool* buffer_pool_;
+    GroupLayout layout_;
+    uint32_t radix_bits_;
+    size_t partition_budget_;
+    std::vector<Partition> partitions_;
+    std::vector<std::unique_ptr<SpillFile>> spills_;
+};
+
+// Fast path for low-cardinality groups: a single INTEGER or BOOLEAN
+// group key whose value range (from catalog statistics or the first
+// chunk) is at most DIRECT_AGGREGATION_MAX_GROUPS wide. States live in
+// a dense array indexed by key - min_key, no hashing at all. Each
+// thread owns one array; merging adds arrays element-wise.
+class DirectAggregateTable {
+public:
+    static constexpr size_t DIRECT_AGGREGATION_MAX_GROUPS = 1 << 16;
+
+    DirectAggregateTable(int64_t min_key, int64_t max_key, size_t num_aggregates);
+
+    static bool Applicable(int64_t min_key, int64_t max_key) {
+        // Subtract in uint64_t: max_key - min_key overflows int64_t for
+        // wide ranges
+        return max_key >= min_key &&
+               static_cast<uint64_t>(max_key) - static_cast<uint64_t>(min_key) <
+                   DIRECT_AGGREGATION_MAX_GROUPS;
+    }
+
+    // Returns false when a key falls outside the range; the caller then
+    // converts to the hash path with ToGroups()
+    bool Sink(const DataChunk& chunk, uint32_t key_column,
+              const std::vector<std::pair<AggregateType, int32_t>>& aggregates);
+    void Merge(const DirectAggregateTable& other,
+               const std::vector<AggregateType>& types);
+    void ToGroups(const GroupLayout& layout, std::vector<char>* groups) const;
+
+    int64_t GetMinKey() const { return min_key_; }
+    size_t GetRange() const { return present_.size(); }
+    bool IsPresent(size_t index) const { return present_[index] != 0; }
+    const AggregateState* GetStates(size_t index) const {
+        return &states_[index * num_aggregates_];
+    }
+
+private:
+    int64_t min_key_;
+    size_t num_aggregates_;
+    std::vector<uint8_t> present_;
+    std::vector<AggregateState> states_;
+};
+
+} // namespace mokshith
\ No newline at end of file
@@ -0,0 +1,139 @@
+#pragma once
+#include "common/types.h"
+#include "catalog/schema.h"
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mokshith {
+
+class Tuple;
+class TupleView;
+
+// Rows per DataChunk; small enough that a chunk of a few columns stays
+// in L2, large enough to amortize one virtual call per operator
+static constexpr size_t VECTOR_SIZE = 1024;
+
+enum class VectorType : uint8_t {
+    INTEGER,
+    FLOAT,
+    BOOLEAN,
+    VARCHAR
+};
+
+// Selected row positions of a chunk, in ascending order. An inactive
+// selection vector means every row in [0, count) is selected.
+class SelectionVector {
+public:
+    SelectionVector() : indices_(new uint16_t[VECTOR_SIZE]), size_(0), active_(false) {}
+
+    bool IsActive() const { return active_; }
+    size_t Size() const { return size_; }
+    uint16_t Get(size_t i) const { return active_ ? indices_[i] : static_cast<uint16_t>(i); }
+    uint16_t* Data() { return indices_.get(); }
+
+    void SetSize(size_t size) {
+        size_ = size;
+        active_ = true;
+    }
+    void Reset() {
+        size_ = 0;
+        active_ = false;
+    }
+
+private:
+    std::unique_ptr<uint16_t[]> indices_;
+    size_t size_;
+    bool active_;
+};
+
+// One typed column of a chunk. Fixed-width types are stored unboxed in
+// `data_`; VARCHAR stores (pointer, length) pairs whose bytes live either
+// in a pinned page or in the vector's own string arena.
+class ColumnVector {
+public:
+    struct StringRef {
+        const char* data;
+        uint32_t length;
+    };
+
+    explicit ColumnVector(VectorType type);
+
+    VectorType GetType() const { return type_; }
+    static size_t TypeWidth(VectorType type) {
+        switch (type) {
+            case VectorType::INTEGER: return sizeof(int32_t);
+            case VectorType::FLOAT: return sizeof(float);
+            case VectorType::BOOLEAN: return sizeof(uint8_t);
+            case VectorType::VARCHAR: return sizeof(StringRef);
+        }
+        return 0;
+    }
+
+    template <typename T>
+    T* GetData() { return reinterpret_cast<T*>(data_.get()); }
+    template <typename T>
+    const T* GetData() const { return reinterpret_cast<const T*>(data_.get()); }
+
+    // Validity bitmap, bit set = NULL; all-valid vectors skip the check
+    bool HasNulls() const { return has_nulls_; }
+    bool IsNull(size_t row) const { return has_nulls_ && (nulls_[row / 64] >> (row % 64)) & 1; }
+    void SetNull(size_t row) {
+        nulls_[row / 64] |= uint64_t(1) << (row % 64);
+        has_nulls_ = true;
+    }
+
+    // Boxes one entry; only for tuple adapters and tests
+    Value GetValue(size_t row) const;
+    void SetValue(size_t row, const Value& value);
+
+    // Copies string bytes into the arena, for strings not backed by a page
+    StringRef AddString(const char* data, uint32_t length);
+
+    void Reset();
+
+private:
+    VectorType type_;
+    std::unique_ptr<char[]> data_;
+    uint64_t nulls_[VECTOR_SIZE / 64];
+    bool has_nulls_;
+    std::vector<std::unique_ptr<char[]>> string_arena_;
+};
+
+// A batch of up to VECTOR_SIZE rows in columnar form
+class DataChunk {
+public:
+    DataChunk() : count_(0) {}
+
+    void Initialize(const std::vector<VectorType>& types);
+    void Initialize(const Schema* schema);
+
+    size_t ColumnCount() const { return columns_.size(); }
+    ColumnVector& GetColumn(size_t idx) { return *columns_[idx]; }
+    const ColumnVector& GetColumn(size_t idx) const { return *columns_[idx]; }
+
+    // Physical rows in the chunk, before selection
+    size_t GetCount() const { return count_; }
+    void SetCount(size_t count) { count_ = count; }
+    // Rows that survive the selection vector
+    size_t GetSelectedCount() const { return selection_.IsActive() ? selection_.Size() : count_; }
+
+    SelectionVector& GetSelection() { return selection_; }
+    const SelectionVector& GetSelection() const { return selection_; }
+
+    bool IsFull() const { return count_ == VECTOR_SIZE; }
+    void Reset();
+
+    // Tuple adapters
+    void AppendTuple(const Tuple& tuple, const Schema* schema);
+    void AppendTuple(const TupleView& view, const Schema* schema);
+    Tuple GetTuple(size_t selected_idx, const Schema* schema) const;
+
+private:
+    std::vector<std::unique_ptr<ColumnVector>> columns_;
+    size_t count_;
+    SelectionVector selection_;
+};
+
+} // namespace mokshith
\ No newline at end of file
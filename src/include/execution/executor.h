@@ -1,7 +1,14 @@
 #pragma once
 #include "planner/plan_node.h"
 #include "storage/tuple.h"
+#include "storage/pax_table.h"
 #include "execution/execution_context.h"
+#include "execution/data_chunk.h"
+#include "execution/vectorized_predicate.h"
+#include "execution/join_hash_table.h"
+#include "execution/aggregate_hash_table.h"
+#include "execution/external_sort.h"
+#include "execution/spill.h"
 
 namespace mokshith {
 
@@ -12,12 +19,74 @@ public:
     
     virtual ~Executor() = default;
     
+    virtual const Schema* GetOutputSchema() const { return plan_->GetOutputSchema().get(); }
+    
     virtual void Init() = 0;
     virtual bool Next(Tuple* tuple) = 0;
     
+    // Zero-copy variant: the view stays valid until the next call. The
+    // default adapts Next() for operators that produce owned tuples.
+    virtual bool NextView(TupleView* view) {
+        if (!Next(&view_buffer_)) return false;
+        *view = TupleView(view_buffer_);
+        return true;
+    }
+    
+    // Vectorized variant: fills up to VECTOR_SIZE rows of `chunk`, which
+    // the caller has Initialize()d with the output schema. Returns false
+    // once exhausted. Operators that only implement Next() are adapted
+    // here, one row at a time; batch-native operators override it and
+    // return true from SupportsBatch().
+    virtual bool NextBatch(DataChunk* chunk) {
+        chunk->Reset();
+        const Schema* schema = GetOutputSchema();
+        while (!chunk->IsFull() && Next(&view_buffer_)) {
+            chunk->AppendTuple(view_buffer_, schema);
+        }
+        return chunk->GetCount() > 0;
+    }
+    
+    virtual bool SupportsBatch() const { return false; }
+    
 protected:
     ExecutionContext* exec_ctx_;
     std::shared_ptr<PlanNode> plan_;
+    
+private:
+    Tuple view_buffer_;
+};
+
+// Serves Next() from a batch-native child, so tuple-at-a-time parents
+// can sit on top of vectorized pipelines
+class BatchToTupleExecutor : public Executor {
+public:
+    BatchToTupleExecutor(ExecutionContext* exec_ctx, std::unique_ptr<Executor> child)
+        : Executor(exec_ctx, nullptr), child_(std::move(child)), position_(0) {}
+    
+    const Schema* GetOutputSchema() const override { return child_->GetOutputSchema(); }
+    
+    void Init() override {
+        child_->Init();
+        chunk_.Initialize(child_->GetOutputSchema());
+        position_ = 0;
+    }
+    
+    bool Next(Tuple* tuple) override {
+        while (position_ >= chunk_.GetSelectedCount()) {
+            if (!child_->NextBatch(&chunk_)) return false;
+            position_ = 0;
+        }
+        *tuple = chunk_.GetTuple(position_++, child_->GetOutputSchema());
+        return true;
+    }
+    
+    bool NextBatch(DataChunk* chunk) override { return child_->NextBatch(chunk); }
+    bool SupportsBatch() const override { return true; }
+    
+private:
+    std::unique_ptr<Executor> child_;
+    DataChunk chunk_;
+    size_t position_;
 };
 
 class SeqScanExecutor : public Executor {
@@ -26,13 +95,33 @@ public:
                     std::shared_ptr<SeqScanPlan> plan);
     
     void Init() override;
+    // Next() materializes the row NextView() returns
     bool Next(Tuple* tuple) override;
+    // Evaluates the predicate on the view, no per-row allocation
+    bool NextView(TupleView* view) override;
+    // Decodes a page's worth of rows straight into column vectors, then
+    // evaluates the predicate over the chunk into its selection vector
+    bool NextBatch(DataChunk* chunk) override;
+    bool SupportsBatch() const override { return true; }
     
 private:
     std::shared_ptr<SeqScanPlan> plan_;
     TableHeap* table_heap_;
     TableHeap::Iterator iter_;
     TableHeap::Iterator end_;
+    
+    // PAX tables: only the plan's projected columns are read, rows are
+    // assembled into out_tuple_ in projection order
+    PaxTableHeap* pax_heap_;
+    std::unique_ptr<PaxTableHeap::ColumnIterator> pax_iter_;
+    
+    // Kernel-based predicate for NextBatch, null if the predicate has to
+    // be interpreted per row
+    std::unique_ptr<VectorizedPredicate> vectorized_predicate_;
+    std::vector<Value> pax_values_;
+    Tuple out_tuple_;
+    
+    bool NextPax(Tuple* tuple);
 };
 
 class InsertExecutor : public Executor {
@@ -43,6 +132,10 @@ public:
     
     void Init() override;
     bool Next(Tuple* tuple) override;
+    // Pulls batches from the child and inserts every selected row;
+    // produces a single one-row chunk holding the insert count
+    bool NextBatch(DataChunk* chunk) override;
+    bool SupportsBatch() const override { return true; }
     
 private:
     std::shared_ptr<InsertPlan> plan_;
@@ -58,12 +151,242 @@ public:
     
     void Init() override;
     bool Next(Tuple* tuple) override;
+    // Collects up to VECTOR_SIZE RIDs from the leaf, sorts them by page
+    // and fetches each heap page once per chunk
+    bool NextBatch(DataChunk* chunk) override;
+    bool SupportsBatch() const override { return true; }
     
 private:
     std::shared_ptr<IndexScanPlan> plan_;
     BPlusTreeIndex* index_;
     IndexIterator iter_;
     IndexIterator end_;
+    
+    // Leaves prefetched ahead of the iterator, 0 for point lookups
+    size_t read_ahead_leaves_;
+    std::vector<RID> rid_batch_;
+};
+
+class FilterExecutor : public Executor {
+public:
+    FilterExecutor(ExecutionContext* exec_ctx,
+                   std::shared_ptr<FilterPlan> plan,
+                   std::unique_ptr<Executor> child_executor);
+    
+    void Init() override;
+    bool Next(Tuple* tuple) override;
+    // Narrows the child's selection vector; rows are never copied
+    bool NextBatch(DataChunk* chunk) override;
+    bool SupportsBatch() const override { return true; }
+    
+private:
+    std::shared_ptr<FilterPlan> plan_;
+    std::unique_ptr<Executor> child_executor_;
+    std::unique_ptr<VectorizedPredicate> vectorized_predicate_;
+};
+
+class ProjectionExecutor : public Executor {
+public:
+    ProjectionExecutor(ExecutionContext* exec_ctx,
+                       std::shared_ptr<ProjectionPlan> plan,
+                       std::unique_ptr<Executor> child_executor);
+    
+    void Init() override;
+    bool Next(Tuple* tuple) override;
+    // Column references are passed through as vector copies of the
+    // selected rows, other expressions are evaluated per chunk
+    bool NextBatch(DataChunk* chunk) override;
+    bool SupportsBatch() const override { return true; }
+    
+private:
+    std::shared_ptr<ProjectionPlan> plan_;
+    std::unique_ptr<Executor> child_executor_;
+    DataChunk child_chunk_;
+};
+
+// Radix-partitioned hash join with hybrid-hash spilling.
+//
+// Build: rows from the build child are serialized into per-partition
+// row arenas (RadixPartitioner, bits chosen from the estimated build
+// size so each partition fits in L2). If the total exceeds work_mem,
+// the largest in-memory partitions are moved to SpillFiles until it
+// fits. The hash tables of the in-memory partitions are then built in
+// parallel on the WorkStealingScheduler, one task per partition.
+//
+// Probe: probe rows of in-memory partitions are joined immediately;
+// those of spilled partitions are written to a matching probe
+// SpillFile. When the probe child is exhausted, each spilled (build,
+// probe) pair is joined in turn, re-partitioning with the next hash
+// bits if it still does not fit (grace hash join).
+class HashJoinExecutor : public Executor {
+public:
+    HashJoinExecutor(ExecutionContext* exec_ctx,
+                     std::shared_ptr<HashJoinPlan> plan,
+                     std::unique_ptr<Executor> build_executor,
+                     std::unique_ptr<Executor> probe_executor);
+    
+    void Init() override;
+    bool Next(Tuple* tuple) override;
+    bool NextBatch(DataChunk* chunk) override;
+    bool SupportsBatch() const override { return true; }
+    
+    struct Stats {
+        uint32_t radix_bits;
+        size_t build_rows;
+        size_t spilled_partitions;
+        size_t spilled_pages;
+        size_t recursion_depth;
+    };
+    const Stats& GetStats() const { return stats_; }
+    
+private:
+    struct Partition {
+        std::vector<char> rows;          // serialized build tuples
+        std::vector<uint32_t> offsets;   // row index -> offset in rows
+        std::vector<uint64_t> hashes;
+        JoinHashTable table;
+        std::unique_ptr<SpillFile> build_spill;  // set once spilled
+        std::unique_ptr<SpillFile> probe_spill;
+        
+        bool IsSpilled() const { return build_spill != nullptr; }
+        size_t MemoryUsage() const { return rows.size() + table.MemoryUsage(); }
+    };
+    
+    std::shared_ptr<HashJoinPlan> plan_;
+    std::unique_ptr<Executor> build_executor_;
+    std::unique_ptr<Executor> probe_executor_;
+    
+    size_t memory_budget_;
+    size_t memory_used_;
+    std::unique_ptr<RadixPartitioner> partitioner_;
+    std::vector<Partition> partitions_;
+    
+    // Probe state: current probe chunk, row and match position
+    DataChunk probe_chunk_;
+    size_t probe_position_;
+    std::vector<uint64_t> probe_hashes_;
+    size_t spilled_partition_cursor_;
+    
+    Stats stats_;
+    
+    uint64_t HashKeys(const TupleView& row, const Schema* schema,
+                      const std::vector<std::shared_ptr<CompiledExpression>>& keys) const;
+    void Build();
+    void SpillLargestPartition();
+    void BuildTablesInParallel();
+    bool ProbeInMemory(DataChunk* out);
+    bool JoinSpilledPartitions(DataChunk* out);
+};
+
+// Parallel partitioned hash aggregation.
+//
+// Phase 1 (sink): the child is drained by chunk. Under a Gather the
+// pipeline workers sink their own morsels; each thread aggregates into
+// a thread-local PreAggregationTable (or DirectAggregateTable when the
+// single group key has a small value range).
+// Phase 2 (merge): one task per radix partition merges every thread's
+// groups for that partition; partitions that exceed their share of
+// work_mem spill through SpillFile and are merged afterwards.
+// Phase 3 (scan): HAVING is applied while final groups are emitted.
+class AggregationExecutor : public Executor {
+public:
+    AggregationExecutor(ExecutionContext* exec_ctx,
+                        std::shared_ptr<AggregatePlan> plan,
+                        std::unique_ptr<Executor> child_executor);
+    
+    void Init() override;
+    bool Next(Tuple* tuple) override;
+    bool NextBatch(DataChunk* chunk) override;
+    bool SupportsBatch() const override { return true; }
+    
+    // Thread-safe sink used by parallel pipelines, one call per chunk
+    void Sink(const DataChunk& chunk, size_t thread_id);
+    
+private:
+    struct ThreadState {
+        std::unique_ptr<PreAggregationTable> pre_aggregation;
+        std::unique_ptr<DirectAggregateTable> direct;
+        DataChunk input;  // evaluated keys and aggregate arguments
+    };
+    
+    std::shared_ptr<AggregatePlan> plan_;
+    std::unique_ptr<Executor> child_executor_;
+    
+    GroupLayout layout_;
+    uint32_t radix_bits_;
+    bool use_direct_;
+    std::vector<std::unique_ptr<ThreadState>> thread_states_;
+    std::unique_ptr<PartitionedAggregateTable> merged_;
+    std::unique_ptr<DirectAggregateTable> merged_direct_;
+    
+    // Output cursor
+    uint32_t output_partition_;
+    size_t output_group_;
+    
+    void ChooseStrategy();
+    void Merge();
+    bool EmitGroup(const char* group, DataChunk* out);
+};
+
+// ORDER BY: drains the child into an ExternalSorter bounded by work_mem,
+// then emits rows in key order
+class SortExecutor : public Executor {
+public:
+    SortExecutor(ExecutionContext* exec_ctx,
+                 std::shared_ptr<SortPlan> plan,
+                 std::unique_ptr<Executor> child_executor);
+    
+    void Init() override;
+    bool Next(Tuple* tuple) override;
+    bool NextBatch(DataChunk* chunk) override;
+    bool SupportsBatch() const override { return true; }
+    
+    const ExternalSorter::Stats& GetStats() const { return sorter_->GetStats(); }
+    
+private:
+    std::shared_ptr<SortPlan> plan_;
+    std::unique_ptr<Executor> child_executor_;
+    // Sort keys are evaluated into this chunk's trailing columns
+    DataChunk input_;
+    std::unique_ptr<SortKeyEncoder> encoder_;
+    std::unique_ptr<ExternalSorter> sorter_;
+};
+
+class LimitExecutor : public Executor {
+public:
+    LimitExecutor(ExecutionContext* exec_ctx,
+                  std::shared_ptr<LimitPlan> plan,
+                  std::unique_ptr<Executor> child_executor);
+    
+    void Init() override;
+    bool Next(Tuple* tuple) override;
+    
+private:
+    std::shared_ptr<LimitPlan> plan_;
+    std::unique_ptr<Executor> child_executor_;
+    size_t skipped_;
+    size_t emitted_;
+};
+
+// ORDER BY ... LIMIT N with a TopNHeap of limit + offset entries. Keys
+// are encoded with the full declared width of VARCHAR columns, so the
+// heap order is exact and no tie-break on rows is needed.
+class TopNExecutor : public Executor {
+public:
+    TopNExecutor(ExecutionContext* exec_ctx,
+                 std::shared_ptr<TopNPlan> plan,
+                 std::unique_ptr<Executor> child_executor);
+    
+    void Init() override;
+    bool Next(Tuple* tuple) override;
+    
+private:
+    std::shared_ptr<TopNPlan> plan_;
+    std::unique_ptr<Executor> child_executor_;
+    std::unique_ptr<SortKeyEncoder> encoder_;
+    std::unique_ptr<TopNHeap> heap_;
+    std::vector<size_t> sorted_;
+    size_t position_;
 };
 
 } // namespace mokshith
\ No newline at end of file
@@ -0,0 +1,142 @@
+#pragma once
+#include "execution/data_chunk.h"
+#include "planner/plan_node.h"
+#include "storage/tuple.h"
+#include <memory>
+#include <vector>
+
+namespace mokshith {
+
+// Compact register bytecode for expressions.
+//
+// Every instruction is specialized on its operand types, so evaluation
+// never switches on a Value's type and never boxes: registers are raw
+// int64 / double / bool slots plus a null flag. Column loads decode the
+// column straight from the tuple bytes (or a ColumnVector in batch mode).
+enum class OpCode : uint8_t {
+    // dst <- column / constant
+    LOAD_COL_INT,
+    LOAD_COL_FLOAT,
+    LOAD_COL_BOOL,
+    LOAD_COL_VARCHAR,   // pointer + length into the tuple, no copy
+    LOAD_CONST,         // from the constant pool, already typed
+
+    // Arithmetic, dst <- a op b
+    ADD_INT, SUB_INT, MUL_INT, DIV_INT, MOD_INT,
+    ADD_FLOAT, SUB_FLOAT, MUL_FLOAT, DIV_FLOAT,
+    CAST_INT_FLOAT,
+
+    // Comparisons, dst(bool) <- a op b
+    CMP_INT,            // CompareOp in `aux`
+    CMP_FLOAT,
+    CMP_BOOL,
+    CMP_VARCHAR,
+
+    // Logic with SQL three-valued semantics
+    AND, OR, NOT,
+    IS_NULL, IS_NOT_NULL,
+
+    // Short-circuit: skip `aux` instructions if dst is false / true
+    JUMP_IF_FALSE,
+    JUMP_IF_TRUE,
+
+    RETURN              // result in register `a`
+};
+
+struct Instruction {
+    OpCode op;
+    uint8_t dst;
+    uint8_t a;
+    uint8_t b;
+    uint32_t aux;       // column index, constant index, CompareOp or jump
+};
+
+enum class RegisterType : uint8_t {
+    INTEGER,
+    FLOAT,
+    BOOLEAN,
+    VARCHAR
+};
+
+class CompiledExpression {
+public:
+    RegisterType GetResultType() const { return result_type_; }
+    bool IsConstant() const { return program_.size() == 2 && program_[0].op == OpCode::LOAD_CONST; }
+
+    // Row-at-a-time evaluation on a tuple or a view into a pinned page.
+    // Return false when the result is NULL.
+    bool EvaluateBool(const TupleView& tuple, const Schema* schema, bool* result) const;
+    bool EvaluateInt(const TupleView& tuple, const Schema* schema, int64_t* result) const;
+    bool EvaluateFloat(const TupleView& tuple, const Schema* schema, double* result) const;
+    // Boxes the result; for operators that still build Tuples
+    Value Evaluate(const TupleView& tuple, const Schema* schema) const;
+
+    // Batch evaluation: runs each instruction over all selected rows of
+    // the chunk, with one register vector per register
+    void EvaluateChunk(const DataChunk& chunk, ColumnVector* result) const;
+    // Predicate form: narrows the chunk's selection vector in place
+    size_t FilterChunk(DataChunk* chunk) const;
+
+private:
+    friend class ExpressionCompiler;
+
+    struct Register {
+        union {
+            int64_t i;
+            double f;
+            bool b;
+            ColumnVector::StringRef s;
+        };
+        bool is_null;
+    };
+
+    std::vector<Instruction> program_;
+    std::vector<Register> constants_;
+    std::vector<std::string> string_constants_;  // backing for VARCHAR constants
+    uint8_t num_registers_;
+    RegisterType result_type_;
+
+    void Run(const TupleView& tuple, const Schema* schema, Register* registers) const;
+};
+
+// Lowers expression trees built by Planner::CreateExpression into
+// CompiledExpressions. Runs as a separate stage after
+// Optimizer::Optimize, once the final input schema of every operator is
+// known.
+//
+//   1. Constant folding: subtrees without column references are
+//      evaluated once; `x AND FALSE`, `x OR TRUE`, `x * 1`, `x + 0` are
+//      simplified.
+//   2. Type resolution: implicit INT -> FLOAT casts become explicit
+//      CAST_INT_FLOAT instructions, so every opcode is monomorphic.
+//   3. Emission in post-order. A child's result register goes back on
+//      a free list once its parent has consumed it and the next
+//      instruction takes from that list; AND/OR get short-circuit jumps.
+class ExpressionCompiler {
+public:
+    // nullptr if the expression uses something the bytecode does not
+    // cover (callers keep interpreting it)
+    static std::unique_ptr<CompiledExpression> Compile(const Expression* expr,
+                                                       const Schema* input_schema);
+
+    // Compiles the predicates, projections and join keys of every node
+    // in the plan and attaches them with SetCompiled*()
+    static void CompilePlan(const std::shared_ptr<PlanNode>& plan);
+
+private:
+    explicit ExpressionCompiler(const Schema* input_schema)
+        : input_schema_(input_schema), next_register_(0) {}
+
+    const Expression* FoldConstants(const Expression* expr);
+    uint8_t Emit(const Expression* expr, RegisterType* type);
+    uint8_t AllocateRegister();
+    void FreeRegister(uint8_t reg);
+
+    const Schema* input_schema_;
+    std::unique_ptr<CompiledExpression> result_;
+    std::vector<std::unique_ptr<Expression>> folded_;  // owns folded constants
+    std::vector<uint8_t> free_registers_;
+    uint8_t next_register_;
+};
+
+} // namespace mokshith
\ No newline at end of file
@@ -0,0 +1,116 @@
+#pragma once
+#include "execution/data_chunk.h"
+#include "execution/sort_util.h"
+#include "execution/spill.h"
+#include "planner/plan_node.h"
+#include <memory>
+#include <vector>
+
+namespace mokshith {
+
+// Bytes of a VARCHAR sort column kept in the normalized key; longer
+// strings that tie on the prefix are compared on the full row
+static constexpr uint32_t SORT_STRING_PREFIX = 16;
+// Runs merged at once; each open run pins one buffer pool page
+static constexpr size_t SORT_MAX_MERGE_FAN_IN = 64;
+
+// Encodes the ORDER BY columns of a chunk row into a normalized key
+// (see KeyNormalizer). Sort columns are positions in the input chunk.
+class SortKeyEncoder {
+public:
+    struct Column {
+        uint32_t column_idx;
+        VectorType type;
+        bool descending;
+        bool nulls_first;
+        uint32_t prefix_length;   // VARCHAR only
+    };
+
+    SortKeyEncoder(const Schema* input_schema, const std::vector<OrderByExpression>& order_bys,
+                   uint32_t string_prefix = SORT_STRING_PREFIX);
+
+    size_t GetKeySize() const { return key_size_; }
+    // True if some VARCHAR key may be truncated, so memcmp ties need a
+    // full comparison
+    bool NeedsTieBreak() const { return needs_tie_break_; }
+
+    // Returns true if a string was truncated for this row
+    bool Encode(const DataChunk& chunk, size_t row, char* out) const;
+    // Full comparison of two serialized rows on the sort columns
+    int CompareRows(const char* a, const char* b) const;
+
+private:
+    const Schema* input_schema_;
+    std::vector<Column> columns_;
+    size_t key_size_;
+    bool needs_tie_break_;
+};
+
+// External merge sort within a memory budget.
+//
+// Run generation: rows are appended as | key | serialized row | entries
+// to an in-memory arena with a parallel array of entry offsets. When the
+// arena reaches the budget, the offsets are sorted by memcmp on the key
+// (falling back to CompareRows on truncated-string ties) and the run is
+// written in order to a SpillFile.
+//
+// Merge: runs are combined SORT_MAX_MERGE_FAN_IN at a time with a
+// LoserTree over one SpillFile::Reader per run, until a single merge
+// pass can produce the output. If everything fit in memory, no run is
+// written and the output is served from the sorted arena directly.
+class ExternalSorter {
+public:
+    ExternalSorter(BufferPool* buffer_pool, const SortKeyEncoder* encoder, size_t memory_budget);
+    ~ExternalSorter();
+
+    // Adds the selected rows of a chunk
+    void Sink(const DataChunk& chunk, const Schema* schema);
+    // Ends input; returns false if a run could not be written
+    bool Finish();
+    // Sorted rows; *row points at the serialized tuple and stays valid
+    // until the next call
+    bool Next(const char** row, uint32_t* length);
+
+    struct Stats {
+        size_t rows;
+        size_t runs;
+        size_t merge_passes;
+        size_t spilled_pages;
+    };
+    const Stats& GetStats() const { return stats_; }
+
+private:
+    struct RunLess {
+        ExternalSorter* sorter;
+        bool operator()(size_t a, size_t b) const;
+    };
+
+    BufferPool* buffer_pool_;
+    const SortKeyEncoder* encoder_;
+    size_t memory_budget_;
+
+    // Current run
+    std::vector<char> arena_;
+    std::vector<uint32_t> entries_;
+    size_t output_position_;
+
+    // Spilled runs and the final merge
+    std::vector<std::unique_ptr<SpillFile>> runs_;
+    std::vector<SpillFile::Reader> readers_;
+    std::vector<const char*> heads_;
+    std::vector<uint32_t> head_lengths_;
+    std::unique_ptr<LoserTree<RunLess>> merge_;
+    bool merge_started_;
+
+    Stats stats_;
+
+    bool EntryLess(const char* a, const char* b) const;
+    void SortRun();
+    bool SpillRun();
+    // Merges runs_[first, first + count) into one new run
+    bool MergeRuns(size_t first, size_t count);
+    void StartMerge(size_t first, size_t count);
+    bool NextMerged(const char** entry, uint32_t* length);
+};
+
+} // namespace mokshith
\ No newline at end of file
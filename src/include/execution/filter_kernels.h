@@ -0,0 +1,419 @@
+#pragma once
+#include "common/types.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define MOKSHITH_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace mokshith {
+
+// Vectorized filter kernels.
+//
+// Every kernel evaluates one predicate over `count` contiguous values
+// and writes a bitmask (bit i set = row i matches) of
+// MaskWords(count) uint64_t words. AND/OR/NOT combine masks word by
+// word and MaskToSelection() turns the final mask into a selection
+// vector. The SSE4.2 / AVX2 variants are picked once at runtime from
+// CPUID; the scalar variants are the fallback and the reference.
+namespace filter {
+
+enum class CpuLevel {
+    SCALAR,
+    SSE42,
+    AVX2
+};
+
+inline CpuLevel DetectCpuLevel() {
+#ifdef MOKSHITH_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return CpuLevel::AVX2;
+    if (__builtin_cpu_supports("sse4.2")) return CpuLevel::SSE42;
+#endif
+    return CpuLevel::SCALAR;
+}
+
+// Level used by the dispatching kernels; SetCpuLevel() lowers it for
+// tests and benchmarks (it is never raised above what CPUID reports)
+inline CpuLevel& ActiveCpuLevel() {
+    static CpuLevel level = DetectCpuLevel();
+    return level;
+}
+inline CpuLevel GetCpuLevel() { return ActiveCpuLevel(); }
+inline void SetCpuLevel(CpuLevel level) {
+    ActiveCpuLevel() = std::min(level, DetectCpuLevel());
+}
+
+inline size_t MaskWords(size_t count) { return (count + 63) / 64; }
+
+// ---------------------------------------------------------------------
+// Scalar reference kernels
+
+template <typename T>
+inline bool CompareScalar(T lhs, CompareOp op, T rhs) {
+    switch (op) {
+        case CompareOp::EQ: return lhs == rhs;
+        case CompareOp::NE: return lhs != rhs;
+        case CompareOp::LT: return lhs < rhs;
+        case CompareOp::LE: return lhs <= rhs;
+        case CompareOp::GT: return lhs > rhs;
+        case CompareOp::GE: return lhs >= rhs;
+    }
+    return false;
+}
+
+template <typename T>
+inline void CompareConstantScalar(const T* data, size_t begin, size_t count,
+                                  CompareOp op, T constant, uint64_t* mask) {
+    for (size_t i = begin; i < count; ++i) {
+        if (CompareScalar(data[i], op, constant)) {
+            mask[i / 64] |= uint64_t(1) << (i % 64);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------
+// SIMD kernels. Each handles the largest multiple of its lane count and
+// returns how many values it covered; the caller finishes with scalar.
+
+#ifdef MOKSHITH_X86_SIMD
+
+// Lane bits -> mask, `lanes` bits starting at row i
+inline void SetMaskBits(uint64_t* mask, size_t i, uint32_t bits) {
+    mask[i / 64] |= static_cast<uint64_t>(bits) << (i % 64);
+}
+
+__attribute__((target("sse4.2")))
+inline size_t CompareInt32SSE42(const int32_t* data, size_t count,
+                                CompareOp op, int32_t constant, uint64_t* mask) {
+    const __m128i c = _mm_set1_epi32(constant);
+    size_t n = count & ~size_t(3);
+    for (size_t i = 0; i < n; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i r;
+        bool negate = false;
+        switch (op) {
+            case CompareOp::EQ: r = _mm_cmpeq_epi32(v, c); break;
+            case CompareOp::NE: r = _mm_cmpeq_epi32(v, c); negate = true; break;
+            case CompareOp::GT: r = _mm_cmpgt_epi32(v, c); break;
+            case CompareOp::LE: r = _mm_cmpgt_epi32(v, c); negate = true; break;
+            case CompareOp::LT: r = _mm_cmpgt_epi32(c, v); break;
+            case CompareOp::GE: r = _mm_cmpgt_epi32(c, v); negate = true; break;
+            default: r = _mm_setzero_si128(); break;
+        }
+        uint32_t bits = static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(r)));
+        SetMaskBits(mask, i, negate ? (~bits & 0xF) : bits);
+    }
+    return n;
+}
+
+__attribute__((target("avx2")))
+inline size_t CompareInt32AVX2(const int32_t* data, size_t count,
+                               CompareOp op, int32_t constant, uint64_t* mask) {
+    const __m256i c = _mm256_set1_epi32(constant);
+    size_t n = count & ~size_t(7);
+    for (size_t i = 0; i < n; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i r;
+        bool negate = false;
+        switch (op) {
+            case CompareOp::EQ: r = _mm256_cmpeq_epi32(v, c); break;
+            case CompareOp::NE: r = _mm256_cmpeq_epi32(v, c); negate = true; break;
+            case CompareOp::GT: r = _mm256_cmpgt_epi32(v, c); break;
+            case CompareOp::LE: r = _mm256_cmpgt_epi32(v, c); negate = true; break;
+            case CompareOp::LT: r = _mm256_cmpgt_epi32(c, v); break;
+            case CompareOp::GE: r = _mm256_cmpgt_epi32(c, v); negate = true; break;
+            default: r = _mm256_setzero_si256(); break;
+        }
+        uint32_t bits = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(r)));
+        SetMaskBits(mask, i, negate ? (~bits & 0xFF) : bits);
+    }
+    return n;
+}
+
+// _mm_cmpgt_epi64 is the SSE4.2 addition
+__attribute__((target("sse4.2")))
+inline size_t CompareInt64SSE42(const int64_t* data, size_t count,
+                                CompareOp op, int64_t constant, uint64_t* mask) {
+    const __m128i c = _mm_set1_epi64x(constant);
+    size_t n = count & ~size_t(1);
+    for (size_t i = 0; i < n; i += 2) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i r;
+        bool negate = false;
+        switch (op) {
+            case CompareOp::EQ: r = _mm_cmpeq_epi64(v, c); break;
+            case CompareOp::NE: r = _mm_cmpeq_epi64(v, c); negate = true; break;
+            case CompareOp::GT: r = _mm_cmpgt_epi64(v, c); break;
+            case CompareOp::LE: r = _mm_cmpgt_epi64(v, c); negate = true; break;
+            case CompareOp::LT: r = _mm_cmpgt_epi64(c, v); break;
+            case CompareOp::GE: r = _mm_cmpgt_epi64(c, v); negate = true; break;
+            default: r = _mm_setzero_si128(); break;
+        }
+        uint32_t bits = static_cast<uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(r)));
+        SetMaskBits(mask, i, negate ? (~bits & 0x3) : bits);
+    }
+    return n;
+}
+
+__attribute__((target("avx2")))
+inline size_t CompareInt64AVX2(const int64_t* data, size_t count,
+                               CompareOp op, int64_t constant, uint64_t* mask) {
+    const __m256i c = _mm256_set1_epi64x(constant);
+    size_t n = count & ~size_t(3);
+    for (size_t i = 0; i < n; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i r;
+        bool negate = false;
+        switch (op) {
+            case CompareOp::EQ: r = _mm256_cmpeq_epi64(v, c); break;
+            case CompareOp::NE: r = _mm256_cmpeq_epi64(v, c); negate = true; break;
+            case CompareOp::GT: r = _mm256_cmpgt_epi64(v, c); break;
+            case CompareOp::LE: r = _mm256_cmpgt_epi64(v, c); negate = true; break;
+            case CompareOp::LT: r = _mm256_cmpgt_epi64(c, v); break;
+            case CompareOp::GE: r = _mm256_cmpgt_epi64(c, v); negate = true; break;
+            default: r = _mm256_setzero_si256(); break;
+        }
+        uint32_t bits = static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(r)));
+        SetMaskBits(mask, i, negate ? (~bits & 0xF) : bits);
+    }
+    return n;
+}
+
+// Ordered, non-signaling predicates: NaN never matches, except NE
+__attribute__((target("sse4.2")))
+inline size_t CompareFloatSSE42(const float* data, size_t count,
+                                CompareOp op, float constant, uint64_t* mask) {
+    const __m128 c = _mm_set1_ps(constant);
+    size_t n = count & ~size_t(3);
+    for (size_t i = 0; i < n; i += 4) {
+        __m128 v = _mm_loadu_ps(data + i);
+        __m128 r;
+        switch (op) {
+            case CompareOp::EQ: r = _mm_cmpeq_ps(v, c); break;
+            case CompareOp::NE: r = _mm_cmpneq_ps(v, c); break;
+            case CompareOp::LT: r = _mm_cmplt_ps(v, c); break;
+            case CompareOp::LE: r = _mm_cmple_ps(v, c); break;
+            case CompareOp::GT: r = _mm_cmpgt_ps(v, c); break;
+            case CompareOp::GE: r = _mm_cmpge_ps(v, c); break;
+            default: r = _mm_setzero_ps(); break;
+        }
+        SetMaskBits(mask, i, static_cast<uint32_t>(_mm_movemask_ps(r)));
+    }
+    return n;
+}
+
+__attribute__((target("avx2")))
+inline size_t CompareFloatAVX2(const float* data, size_t count,
+                               CompareOp op, float constant, uint64_t* mask) {
+    const __m256 c = _mm256_set1_ps(constant);
+    size_t n = count & ~size_t(7);
+    for (size_t i = 0; i < n; i += 8) {
+        __m256 v = _mm256_loadu_ps(data + i);
+        __m256 r;
+        switch (op) {
+            case CompareOp::EQ: r = _mm256_cmp_ps(v, c, _CMP_EQ_OQ); break;
+            case CompareOp::NE: r = _mm256_cmp_ps(v, c, _CMP_NEQ_UQ); break;
+            case CompareOp::LT: r = _mm256_cmp_ps(v, c, _CMP_LT_OQ); break;
+            case CompareOp::LE: r = _mm256_cmp_ps(v, c, _CMP_LE_OQ); break;
+            case CompareOp::GT: r = _mm256_cmp_ps(v, c, _CMP_GT_OQ); break;
+            case CompareOp::GE: r = _mm256_cmp_ps(v, c, _CMP_GE_OQ); break;
+            default: r = _mm256_setzero_ps(); break;
+        }
+        SetMaskBits(mask, i, static_cast<uint32_t>(_mm256_movemask_ps(r)));
+    }
+    return n;
+}
+
+// BOOLEAN columns are one byte per row, compared unsigned as the scalar
+// kernel does. There is no unsigned byte cmpgt, so ordered ops go
+// through min/max: v <= c iff min(v, c) == v, v >= c iff max(v, c) == v;
+// LT and GT are their negations.
+__attribute__((target("avx2")))
+inline size_t CompareBoolAVX2(const uint8_t* data, size_t count,
+                              CompareOp op, uint8_t constant, uint64_t* mask) {
+    const __m256i c = _mm256_set1_epi8(static_cast<char>(constant));
+    size_t n = count & ~size_t(31);
+    for (size_t i = 0; i < n; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i r;
+        bool negate = false;
+        switch (op) {
+            case CompareOp::EQ: r = _mm256_cmpeq_epi8(v, c); break;
+            case CompareOp::NE: r = _mm256_cmpeq_epi8(v, c); negate = true; break;
+            case CompareOp::LE: r = _mm256_cmpeq_epi8(_mm256_min_epu8(v, c), v); break;
+            case CompareOp::GT: r = _mm256_cmpeq_epi8(_mm256_min_epu8(v, c), v); negate = true; break;
+            case CompareOp::GE: r = _mm256_cmpeq_epi8(_mm256_max_epu8(v, c), v); break;
+            case CompareOp::LT: r = _mm256_cmpeq_epi8(_mm256_max_epu8(v, c), v); negate = true; break;
+            default: r = _mm256_setzero_si256(); break;
+        }
+        uint32_t bits = static_cast<uint32_t>(_mm256_movemask_epi8(r));
+        SetMaskBits(mask, i, negate ? ~bits : bits);
+    }
+    return n;
+}
+
+__attribute__((target("sse4.2")))
+inline size_t CompareBoolSSE42(const uint8_t* data, size_t count,
+                               CompareOp op, uint8_t constant, uint64_t* mask) {
+    const __m128i c = _mm_set1_epi8(static_cast<char>(constant));
+    size_t n = count & ~size_t(15);
+    for (size_t i = 0; i < n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i r;
+        bool negate = false;
+        switch (op) {
+            case CompareOp::EQ: r = _mm_cmpeq_epi8(v, c); break;
+            case CompareOp::NE: r = _mm_cmpeq_epi8(v, c); negate = true; break;
+            case CompareOp::LE: r = _mm_cmpeq_epi8(_mm_min_epu8(v, c), v); break;
+            case CompareOp::GT: r = _mm_cmpeq_epi8(_mm_min_epu8(v, c), v); negate = true; break;
+            case CompareOp::GE: r = _mm_cmpeq_epi8(_mm_max_epu8(v, c), v); break;
+            case CompareOp::LT: r = _mm_cmpeq_epi8(_mm_max_epu8(v, c), v); negate = true; break;
+            default: r = _mm_setzero_si128(); break;
+        }
+        uint32_t bits = static_cast<uint32_t>(_mm_movemask_epi8(r));
+        SetMaskBits(mask, i, negate ? (~bits & 0xFFFF) : bits);
+    }
+    return n;
+}
+
+#endif  // MOKSHITH_X86_SIMD
+
+// ---------------------------------------------------------------------
+// Dispatching kernels. `mask` must hold MaskWords(count) words; it is
+// cleared first.
+
+inline void CompareConstant(const int32_t* data, size_t count, CompareOp op,
+                            int32_t constant, uint64_t* mask) {
+    std::memset(mask, 0, MaskWords(count) * sizeof(uint64_t));
+    size_t done = 0;
+#ifdef MOKSHITH_X86_SIMD
+    switch (GetCpuLevel()) {
+        case CpuLevel::AVX2: done = CompareInt32AVX2(data, count, op, constant, mask); break;
+        case CpuLevel::SSE42: done = CompareInt32SSE42(data, count, op, constant, mask); break;
+        default: break;
+    }
+#endif
+    CompareConstantScalar(data, done, count, op, constant, mask);
+}
+
+inline void CompareConstant(const int64_t* data, size_t count, CompareOp op,
+                            int64_t constant, uint64_t* mask) {
+    std::memset(mask, 0, MaskWords(count) * sizeof(uint64_t));
+    size_t done = 0;
+#ifdef MOKSHITH_X86_SIMD
+    switch (GetCpuLevel()) {
+        case CpuLevel::AVX2: done = CompareInt64AVX2(data, count, op, constant, mask); break;
+        case CpuLevel::SSE42: done = CompareInt64SSE42(data, count, op, constant, mask); break;
+        default: break;
+    }
+#endif
+    CompareConstantScalar(data, done, count, op, constant, mask);
+}
+
+inline void CompareConstant(const float* data, size_t count, CompareOp op,
+                            float constant, uint64_t* mask) {
+    std::memset(mask, 0, MaskWords(count) * sizeof(uint64_t));
+    size_t done = 0;
+#ifdef MOKSHITH_X86_SIMD
+    switch (GetCpuLevel()) {
+        case CpuLevel::AVX2: done = CompareFloatAVX2(data, count, op, constant, mask); break;
+        case CpuLevel::SSE42: done = CompareFloatSSE42(data, count, op, constant, mask); break;
+        default: break;
+    }
+#endif
+    CompareConstantScalar(data, done, count, op, constant, mask);
+}
+
+inline void CompareConstant(const uint8_t* data, size_t count, CompareOp op,
+                            uint8_t constant, uint64_t* mask) {
+    std::memset(mask, 0, MaskWords(count) * sizeof(uint64_t));
+    size_t done = 0;
+#ifdef MOKSHITH_X86_SIMD
+    switch (GetCpuLevel()) {
+        case CpuLevel::AVX2: done = CompareBoolAVX2(data, count, op, constant, mask); break;
+        case CpuLevel::SSE42: done = CompareBoolSSE42(data, count, op, constant, mask); break;
+        default: break;
+    }
+#endif
+    CompareConstantScalar(data, done, count, op, constant, mask);
+}
+
+// ---------------------------------------------------------------------
+// Mask combinators
+
+inline void MaskAnd(uint64_t* dst, const uint64_t* src, size_t count) {
+    for (size_t w = 0; w < MaskWords(count); ++w) dst[w] &= src[w];
+}
+
+inline void MaskOr(uint64_t* dst, const uint64_t* src, size_t count) {
+    for (size_t w = 0; w < MaskWords(count); ++w) dst[w] |= src[w];
+}
+
+inline void MaskNot(uint64_t* mask, size_t count) {
+    size_t words = MaskWords(count);
+    for (size_t w = 0; w < words; ++w) mask[w] = ~mask[w];
+    if (count % 64 != 0) mask[words - 1] &= (uint64_t(1) << (count % 64)) - 1;
+}
+
+// lo <= x <= hi
+template <typename T>
+inline void Between(const T* data, size_t count, T lo, T hi, uint64_t* mask) {
+    std::vector<uint64_t> upper(MaskWords(count));
+    CompareConstant(data, count, CompareOp::GE, lo, mask);
+    CompareConstant(data, count, CompareOp::LE, hi, upper.data());
+    MaskAnd(mask, upper.data(), count);
+}
+
+// x IN (values...): one EQ pass per value for short lists, a sorted
+// binary search per row for long ones
+template <typename T>
+inline void InList(const T* data, size_t count, const std::vector<T>& values, uint64_t* mask) {
+    static constexpr size_t SIMD_IN_LIST_MAX = 8;
+    if (values.size() <= SIMD_IN_LIST_MAX) {
+        std::vector<uint64_t> eq(MaskWords(count));
+        std::memset(mask, 0, MaskWords(count) * sizeof(uint64_t));
+        for (const T& value : values) {
+            CompareConstant(data, count, CompareOp::EQ, value, eq.data());
+            MaskOr(mask, eq.data(), count);
+        }
+        return;
+    }
+    std::vector<T> sorted(values);
+    std::sort(sorted.begin(), sorted.end());
+    std::memset(mask, 0, MaskWords(count) * sizeof(uint64_t));
+    for (size_t i = 0; i < count; ++i) {
+        if (std::binary_search(sorted.begin(), sorted.end(), data[i])) {
+            mask[i / 64] |= uint64_t(1) << (i % 64);
+        }
+    }
+}
+
+// Writes the set bit positions of `mask` to `selection`, returns how many
+inline size_t MaskToSelection(const uint64_t* mask, size_t count, uint16_t* selection) {
+    size_t n = 0;
+    for (size_t w = 0; w < MaskWords(count); ++w) {
+        uint64_t bits = mask[w];
+        while (bits != 0) {
+            selection[n++] = static_cast<uint16_t>(w * 64 + __builtin_ctzll(bits));
+            bits &= bits - 1;
+        }
+    }
+    return n;
+}
+
+// Sets the bits of an existing selection vector, for ANDing a kernel's
+// result with a chunk's incoming selection
+inline void SelectionToMask(const uint16_t* selection, size_t size, size_t count, uint64_t* mask) {
+    std::memset(mask, 0, MaskWords(count) * sizeof(uint64_t));
+    for (size_t i = 0; i < size; ++i) {
+        mask[selection[i] / 64] |= uint64_t(1) << (selection[i] % 64);
+    }
+}
+
+}  // namespace filter
+
+} // namespace mokshith
\ No newline at end of file
@@ -0,0 +1,113 @@
+#pragma once
+#include "common/types.h"
+#include <cstring>
+#include <vector>
+
+namespace mokshith {
+
+// Assumed per-core L2 size used to size radix partitions
+static constexpr size_t L2_CACHE_SIZE = 256 * 1024;
+static constexpr uint32_t MAX_RADIX_BITS = 10;
+
+// Radix partitioning on the hash. Partition bits are taken from the top
+// of the hash so that the bits used for the in-partition hash table
+// (the low bits) stay independent of the partition number.
+class RadixPartitioner {
+public:
+    // Fewest bits such that each partition's build rows plus hash table
+    // fit in L2, assuming a uniform hash
+    static uint32_t ChooseBits(size_t build_bytes, size_t build_rows) {
+        size_t table_bytes = build_bytes + build_rows * 2 * 16;  // 16-byte slots, 50% load
+        uint32_t bits = 0;
+        while (bits < MAX_RADIX_BITS && (table_bytes >> bits) > L2_CACHE_SIZE / 2) ++bits;
+        return bits;
+    }
+
+    explicit RadixPartitioner(uint32_t bits) : bits_(bits) {}
+
+    uint32_t GetNumPartitions() const { return 1u << bits_; }
+    uint32_t GetPartition(uint64_t hash) const {
+        return bits_ == 0 ? 0 : static_cast<uint32_t>(hash >> (64 - bits_));
+    }
+
+private:
+    uint32_t bits_;
+};
+
+// Compact open-addressing hash table for one join partition.
+//
+// Slots are 16 bytes (full hash, row index) in a power-of-two array with
+// linear probing, so a probe is one or two cache lines. Duplicate keys
+// occupy separate slots; Probe() visits every slot with the same hash
+// until the first empty slot. The table never stores keys: the caller
+// checks key equality on the rows it gets back.
+class JoinHashTable {
+public:
+    static constexpr uint64_t EMPTY = 0;
+
+    explicit JoinHashTable(size_t expected_rows = 0) : mask_(0), size_(0) {
+        Reserve(expected_rows);
+    }
+
+    // Sizes the table for `rows` entries at <= 50% load; drops contents
+    void Reserve(size_t rows) {
+        size_t capacity = 16;
+        while (capacity < rows * 2) capacity <<= 1;
+        slots_.assign(capacity, Slot{EMPTY, 0});
+        mask_ = capacity - 1;
+        size_ = 0;
+    }
+
+    void Insert(uint64_t hash, uint32_t row) {
+        hash = Normalize(hash);
+        if ((size_ + 1) * 2 > slots_.size()) Grow();
+        size_t pos = hash & mask_;
+        while (slots_[pos].hash != EMPTY) pos = (pos + 1) & mask_;
+        slots_[pos] = Slot{hash, row};
+        ++size_;
+    }
+
+    // Calls on_match(row) for each entry whose hash equals `hash`; stops
+    // early if on_match returns false
+    template <typename F>
+    void Probe(uint64_t hash, F&& on_match) const {
+        hash = Normalize(hash);
+        size_t pos = hash & mask_;
+        while (slots_[pos].hash != EMPTY) {
+            if (slots_[pos].hash == hash && !on_match(slots_[pos].row)) return;
+            pos = (pos + 1) & mask_;
+        }
+    }
+
+    size_t Size() const { return size_; }
+    size_t Capacity() const { return slots_.size(); }
+    size_t MemoryUsage() const { return slots_.size() * sizeof(Slot); }
+
+private:
+    struct Slot {
+        uint64_t hash;
+        uint32_t row;
+    };
+
+    // Hash 0 marks an empty slot
+    static uint64_t Normalize(uint64_t hash) { return hash == EMPTY ? 1 : hash; }
+
+    void Grow() {
+        std::vector<Slot> old;
+        old.swap(slots_);
+        slots_.assign(old.size() * 2, Slot{EMPTY, 0});
+        mask_ = slots_.size() - 1;
+        for (const Slot& slot : old) {
+            if (slot.hash == EMPTY) continue;
+            size_t pos = slot.hash & mask_;
+            while (slots_[pos].hash != EMPTY) pos = (pos + 1) & mask_;
+            slots_[pos] = slot;
+        }
+    }
+
+    std::vector<Slot> slots_;
+    size_t mask_;
+    size_t size_;
+};
+
+} // namespace mokshith
\ No newline at end of file
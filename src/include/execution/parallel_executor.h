@@ -0,0 +1,128 @@
+#pragma once
+#include "common/config.h"
+#include "execution/executor.h"
+#include "execution/scheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace mokshith {
+
+// A contiguous slice of a table's page list
+struct Morsel {
+    size_t first_index;   // into MorselSource's page list
+    size_t num_pages;
+};
+
+// Hands out morsels of a table with an atomic cursor. The page list is
+// collected once by walking the heap's page chain headers, so workers
+// never follow next_page_id themselves.
+class MorselSource {
+public:
+    MorselSource(std::vector<page_id_t> page_ids, size_t morsel_pages)
+        : page_ids_(std::move(page_ids)), morsel_pages_(morsel_pages), next_(0) {}
+
+    bool Next(Morsel* morsel) {
+        size_t first = next_.fetch_add(morsel_pages_);
+        if (first >= page_ids_.size()) return false;
+        morsel->first_index = first;
+        morsel->num_pages = std::min(morsel_pages_, page_ids_.size() - first);
+        return true;
+    }
+
+    page_id_t GetPageId(size_t index) const { return page_ids_[index]; }
+    size_t GetNumPages() const { return page_ids_.size(); }
+
+private:
+    std::vector<page_id_t> page_ids_;
+    size_t morsel_pages_;
+    std::atomic<size_t> next_;
+};
+
+// Bounded MPSC queue of finished chunks between the pipeline workers and
+// the gathering consumer (the exchange). Producers block when the
+// consumer falls behind, which bounds memory to capacity chunks.
+class ChunkExchange {
+public:
+    explicit ChunkExchange(size_t capacity) : capacity_(capacity), producers_(0) {}
+
+    void AddProducer() { ++producers_; }
+    void ProducerDone();
+
+    void Push(std::unique_ptr<DataChunk> chunk);
+    // False once every producer is done and the queue is drained
+    bool Pop(std::unique_ptr<DataChunk>* chunk);
+
+    // Recycled chunks, so steady state allocates nothing
+    std::unique_ptr<DataChunk> AcquireChunk(const Schema* schema);
+    void ReleaseChunk(std::unique_ptr<DataChunk> chunk);
+
+private:
+    size_t capacity_;
+    size_t producers_;
+    std::mutex latch_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::deque<std::unique_ptr<DataChunk>> queue_;
+    std::vector<std::unique_ptr<DataChunk>> free_chunks_;
+};
+
+// Parallel-aware scan -> filter -> projection pipeline. Each task pulls
+// a morsel, decodes its pages into chunks, applies the compiled
+// predicate and projection, and pushes results into the exchange. Tasks
+// re-submit themselves while morsels remain, so a worker that finishes
+// early simply picks up the next morsel or steals.
+class ParallelScanPipeline {
+public:
+    ParallelScanPipeline(ExecutionContext* exec_ctx,
+                         std::shared_ptr<SeqScanPlan> scan_plan,
+                         std::shared_ptr<FilterPlan> filter_plan,          // nullable
+                         std::shared_ptr<ProjectionPlan> projection_plan,  // nullable
+                         ChunkExchange* exchange);
+
+    // Starts `degree` tasks on the scheduler
+    void Start(WorkStealingScheduler* scheduler, size_t degree, size_t morsel_pages);
+    void Wait();
+    void Cancel() { cancelled_.store(true); }
+
+private:
+    ExecutionContext* exec_ctx_;
+    std::shared_ptr<SeqScanPlan> scan_plan_;
+    std::shared_ptr<FilterPlan> filter_plan_;
+    std::shared_ptr<ProjectionPlan> projection_plan_;
+    ChunkExchange* exchange_;
+
+    TableHeap* table_heap_;
+    std::unique_ptr<MorselSource> morsels_;
+    std::unique_ptr<TaskGroup> tasks_;
+    std::atomic<bool> cancelled_;
+
+    void RunMorsel(const Morsel& morsel, DataChunk* scratch);
+    void RunWorkerTask();
+};
+
+// Gather: the serial operator on top of a parallel pipeline. Init()
+// starts the workers; Next()/NextBatch() drain the exchange. Row order
+// across morsels is not preserved.
+class GatherExecutor : public Executor {
+public:
+    GatherExecutor(ExecutionContext* exec_ctx, std::shared_ptr<GatherPlan> plan);
+    ~GatherExecutor() override;
+
+    void Init() override;
+    bool Next(Tuple* tuple) override;
+    bool NextBatch(DataChunk* chunk) override;
+    bool SupportsBatch() const override { return true; }
+
+private:
+    std::shared_ptr<GatherPlan> plan_;
+    std::unique_ptr<ChunkExchange> exchange_;
+    std::unique_ptr<ParallelScanPipeline> pipeline_;
+    std::unique_ptr<DataChunk> current_;
+    size_t position_;
+};
+
+} // namespace mokshith
\ No newline at end of file
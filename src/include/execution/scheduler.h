@@ -0,0 +1,82 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mokshith {
+
+// Work-stealing thread pool shared by all queries.
+//
+// Each worker owns a deque: it pushes and pops its own tasks at the back
+// (LIFO, cache-warm) and idle workers steal from the front of a random
+// victim's deque (FIFO, oldest and usually largest work first). Tasks
+// submitted from outside a worker go to a shared injection queue.
+class WorkStealingScheduler {
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkStealingScheduler(size_t num_workers = std::thread::hardware_concurrency());
+    ~WorkStealingScheduler();
+
+    WorkStealingScheduler(const WorkStealingScheduler&) = delete;
+    WorkStealingScheduler& operator=(const WorkStealingScheduler&) = delete;
+
+    // From a worker the task goes to that worker's deque
+    void Submit(Task task);
+
+    size_t GetNumWorkers() const { return workers_.size(); }
+    // -1 when called from a non-worker thread
+    static int CurrentWorkerId();
+
+    // Process-wide pool, sized to the hardware
+    static WorkStealingScheduler* Instance();
+
+    uint64_t GetNumSteals() const { return num_steals_.load(); }
+
+private:
+    struct WorkerQueue {
+        std::mutex latch;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::thread> workers_;
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+
+    std::mutex injection_latch_;
+    std::deque<Task> injection_queue_;
+
+    std::mutex sleep_latch_;
+    std::condition_variable sleep_cv_;
+    std::atomic<size_t> pending_tasks_;
+    std::atomic<bool> shutdown_;
+    std::atomic<uint64_t> num_steals_;
+
+    void RunWorker(size_t worker_id);
+    bool PopLocal(size_t worker_id, Task* task);
+    bool PopInjected(Task* task);
+    bool Steal(size_t thief_id, Task* task);
+};
+
+// Counts outstanding tasks of one query so the caller can wait for all
+// of them without blocking other queries' work
+class TaskGroup {
+public:
+    explicit TaskGroup(WorkStealingScheduler* scheduler) : scheduler_(scheduler), pending_(0) {}
+
+    void Run(WorkStealingScheduler::Task task);
+    // Blocks until every task submitted through this group finished
+    void Wait();
+
+private:
+    WorkStealingScheduler* scheduler_;
+    std::atomic<size_t> pending_;
+    std::mutex latch_;
+    std::condition_variable cv_;
+};
+
+} // namespace mokshith
\ No newline at end of file
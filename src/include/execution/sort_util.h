@@ -0,0 +1,216 @@
+#pragma once
+#include "common/types.h"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace mokshith {
+
+// Normalized binary sort keys: every ORDER BY column is encoded into a
+// fixed-width, byte-comparable form so that comparing two rows is a
+// single memcmp over the concatenated key, whatever the column types,
+// directions and NULL placement.
+//
+// Column layout: | null marker (1) | payload |
+// The marker orders NULLs before or after every value independently of
+// the direction; the payload is big-endian and inverted for DESC.
+class KeyNormalizer {
+public:
+    static constexpr uint8_t NULL_FIRST_MARKER = 0;
+    static constexpr uint8_t VALUE_MARKER = 1;
+    static constexpr uint8_t NULL_LAST_MARKER = 2;
+
+    static size_t EncodedSize(size_t payload_size) { return 1 + payload_size; }
+
+    static void EncodeNull(size_t payload_size, bool nulls_first, char* out) {
+        out[0] = static_cast<char>(nulls_first ? NULL_FIRST_MARKER : NULL_LAST_MARKER);
+        std::memset(out + 1, 0, payload_size);
+    }
+
+    static void EncodeInt32(int32_t value, bool descending, char* out) {
+        // Flipping the sign bit maps signed order onto unsigned order
+        uint32_t bits = static_cast<uint32_t>(value) ^ 0x80000000u;
+        out[0] = static_cast<char>(VALUE_MARKER);
+        StoreBigEndian(bits, out + 1);
+        if (descending) Invert(out + 1, sizeof(bits));
+    }
+
+    static void EncodeFloat(float value, bool descending, char* out) {
+        if (value == 0.0f) value = 0.0f;  // -0.0 sorts equal to 0.0
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        // Negative floats: invert everything; positive: set the sign bit
+        bits = (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+        out[0] = static_cast<char>(VALUE_MARKER);
+        StoreBigEndian(bits, out + 1);
+        if (descending) Invert(out + 1, sizeof(bits));
+    }
+
+    static void EncodeBool(bool value, bool descending, char* out) {
+        out[0] = static_cast<char>(VALUE_MARKER);
+        out[1] = static_cast<char>(value ? 1 : 0);
+        if (descending) Invert(out + 1, 1);
+    }
+
+    // Strings are zero-padded or truncated to `prefix_length` bytes.
+    // Returns true if the string was truncated, in which case equal keys
+    // do not imply equal values and the caller must break the tie on the
+    // full row.
+    static bool EncodeString(const char* data, uint32_t length, uint32_t prefix_length,
+                             bool descending, char* out) {
+        out[0] = static_cast<char>(VALUE_MARKER);
+        uint32_t copied = std::min(length, prefix_length);
+        std::memcpy(out + 1, data, copied);
+        std::memset(out + 1 + copied, 0, prefix_length - copied);
+        if (descending) Invert(out + 1, prefix_length);
+        return length > prefix_length;
+    }
+
+private:
+    static void StoreBigEndian(uint32_t bits, char* out) {
+        out[0] = static_cast<char>(bits >> 24);
+        out[1] = static_cast<char>(bits >> 16);
+        out[2] = static_cast<char>(bits >> 8);
+        out[3] = static_cast<char>(bits);
+    }
+
+    static void Invert(char* data, size_t size) {
+        for (size_t i = 0; i < size; ++i) data[i] = static_cast<char>(~data[i]);
+    }
+};
+
+// Tournament tree of losers for the k-way merge of sorted runs.
+//
+// Leaves are the k sources; each inner node keeps the loser of the match
+// played below it and node 0 keeps the overall winner. When the winning
+// source advances, only its leaf-to-root path is replayed: log2(k)
+// comparisons, each against a stored loser, with no sibling lookups as
+// in a plain tournament tree or a heap's sift-down.
+//
+// `less(a, b)` compares the current heads of sources a and b. Ties go to
+// the lower source index, which keeps the merge stable across runs.
+template <typename Less>
+class LoserTree {
+public:
+    LoserTree(size_t num_sources, Less less)
+        : k_(num_sources), less_(less), tree_(std::max<size_t>(num_sources, 1), 0),
+          exhausted_(num_sources, false) {}
+
+    // Plays the whole tournament; call once every source is positioned
+    // on its first row (or marked exhausted)
+    void Build() {
+        if (k_ == 0) return;
+        std::vector<size_t> winners(k_, 0);
+        for (size_t node = k_ - 1; node >= 1; --node) {
+            size_t left = Child(2 * node, winners);
+            size_t right = Child(2 * node + 1, winners);
+            if (Beats(left, right)) {
+                winners[node] = left;
+                tree_[node] = right;
+            } else {
+                winners[node] = right;
+                tree_[node] = left;
+            }
+        }
+        tree_[0] = k_ == 1 ? 0 : winners[1];
+    }
+
+    void MarkExhausted(size_t source) { exhausted_[source] = true; }
+
+    bool Empty() const { return k_ == 0 || exhausted_[tree_[0]]; }
+    size_t Winner() const { return tree_[0]; }
+
+    // Call after the winner's source moved to its next row, or was
+    // marked exhausted
+    void Replay() {
+        size_t winner = tree_[0];
+        for (size_t node = (winner + k_) / 2; node >= 1; node /= 2) {
+            if (Beats(tree_[node], winner)) std::swap(tree_[node], winner);
+        }
+        tree_[0] = winner;
+    }
+
+private:
+    size_t k_;
+    Less less_;
+    std::vector<size_t> tree_;
+    std::vector<bool> exhausted_;
+
+    // Nodes >= k are leaves: source (node - k)
+    size_t Child(size_t node, const std::vector<size_t>& winners) const {
+        return node >= k_ ? node - k_ : winners[node];
+    }
+
+    bool Beats(size_t a, size_t b) const {
+        if (exhausted_[a]) return false;
+        if (exhausted_[b]) return true;
+        if (less_(a, b)) return true;
+        if (less_(b, a)) return false;
+        return a < b;
+    }
+};
+
+// Bounded max-heap of the N smallest normalized keys seen so far, for
+// ORDER BY ... LIMIT N. Memory is N keys plus N rows no matter how many
+// rows are pushed, so Top-N never spills. Row buffers of evicted entries
+// are reused by the entry that replaces them.
+class TopNHeap {
+public:
+    TopNHeap(size_t limit, size_t key_size) : limit_(limit), key_size_(key_size) {}
+
+    // Cheap check on the key alone, so rejected rows are never serialized
+    bool Accepts(const char* key) const {
+        if (limit_ == 0) return false;
+        if (heap_.size() < limit_) return true;
+        return std::memcmp(key, keys_.data() + heap_.front() * key_size_, key_size_) < 0;
+    }
+
+    void Push(const char* key, const char* row, uint32_t length) {
+        if (!Accepts(key)) return;
+        size_t slot;
+        if (heap_.size() < limit_) {
+            slot = rows_.size();
+            rows_.emplace_back();
+            keys_.resize(keys_.size() + key_size_);
+        } else {
+            std::pop_heap(heap_.begin(), heap_.end(), KeyLess{this});
+            slot = heap_.back();
+            heap_.pop_back();
+        }
+        std::memcpy(keys_.data() + slot * key_size_, key, key_size_);
+        rows_[slot].assign(row, length);
+        heap_.push_back(slot);
+        std::push_heap(heap_.begin(), heap_.end(), KeyLess{this});
+    }
+
+    size_t Size() const { return heap_.size(); }
+
+    // Slots in ascending key order; the heap is left empty
+    std::vector<size_t> TakeSorted() {
+        std::sort_heap(heap_.begin(), heap_.end(), KeyLess{this});
+        std::vector<size_t> sorted;
+        sorted.swap(heap_);
+        return sorted;
+    }
+
+    const char* GetKey(size_t slot) const { return keys_.data() + slot * key_size_; }
+    const std::string& GetRow(size_t slot) const { return rows_[slot]; }
+
+private:
+    // With std heap algorithms this keeps the largest key at the front
+    struct KeyLess {
+        const TopNHeap* heap;
+        bool operator()(size_t a, size_t b) const {
+            return std::memcmp(heap->GetKey(a), heap->GetKey(b), heap->key_size_) < 0;
+        }
+    };
+
+    size_t limit_;
+    size_t key_size_;
+    std::vector<char> keys_;
+    std::vector<std::string> rows_;
+    std::vector<size_t> heap_;
+};
+
+} // namespace mokshith
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+#include "storage/page_guard.h"
+#include <vector>
+
+namespace mokshith {
+
+// Temporary row storage on buffer pool pages, used by operators that
+// outgrow their memory budget (hash join, aggregation, sort).
+//
+// Rows are length-prefixed byte strings packed into pages obtained from
+// BufferPool::NewPage. Only the page being written or read is pinned;
+// full pages are unpinned dirty and reach disk through normal eviction
+// or the background writer. Pages are deleted when the file is destroyed.
+//
+// Temp page layout: | PageHeader | uint16 used_bytes | uint16 row_count | rows... |
+// Each row is | uint32 length | bytes |; rows never span pages, rows
+// larger than a page are not supported.
+class SpillFile {
+public:
+    explicit SpillFile(BufferPool* buffer_pool);
+    ~SpillFile();
+
+    SpillFile(const SpillFile&) = delete;
+    SpillFile& operator=(const SpillFile&) = delete;
+
+    // Returns false if the buffer pool could not supply a page
+    bool Append(const char* data, uint32_t length);
+    // Unpins the tail page; required before reading
+    void FinishWrite();
+
+    size_t GetNumRows() const { return num_rows_; }
+    size_t GetNumPages() const { return page_ids_.size(); }
+    size_t GetNumBytes() const { return num_bytes_; }
+
+    class Reader {
+    public:
+        explicit Reader(const SpillFile* file);
+        // *data points into the pinned page and is valid until the next call
+        bool Next(const char** data, uint32_t* length);
+
+    private:
+        const SpillFile* file_;
+        size_t page_index_;
+        uint16_t row_index_;
+        size_t offset_;
+        PageGuard guard_;
+    };
+
+    Reader Read() const { return Reader(this); }
+
+private:
+    // Starts with the PageHeader fields, so Page::GetLSN on a temp page
+    // reads the LSN (never set, INVALID_LSN) rather than row bytes
+    struct TempPageHeader {
+        page_id_t page_id;
+        lsn_t lsn;
+        uint16_t used_bytes;
+        uint16_t row_count;
+    };
+    static constexpr size_t TEMP_PAGE_HEADER_SIZE = sizeof(TempPageHeader);
+    static_assert(offsetof(TempPageHeader, page_id) == offsetof(PageHeader, page_id) &&
+                  offsetof(TempPageHeader, lsn) == offsetof(PageHeader, lsn),
+                  "temp page header must start with PageHeader");
+
+    BufferPool* buffer_pool_;
+    std::vector<page_id_t> page_ids_;
+    Page* tail_page_;
+    size_t num_rows_;
+    size_t num_bytes_;
+};
+
+} // namespace mokshith
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+#include "execution/data_chunk.h"
+#include "execution/filter_kernels.h"
+#include <memory>
+#include <vector>
+
+namespace mokshith {
+
+// A scan predicate lowered onto filter kernels. Built once per scan from
+// SeqScanPlan::GetPredicate() when the tree only contains comparisons,
+// BETWEEN and IN-lists of a column against constants, combined with
+// AND/OR/NOT; anything else keeps the interpreted row-by-row path.
+class VectorizedPredicate {
+public:
+    // nullptr if `predicate` cannot be vectorized
+    static std::unique_ptr<VectorizedPredicate> TryCreate(const Expression* predicate,
+                                                          const Schema* schema);
+
+    // Narrows chunk's selection vector to matching rows, returns the
+    // number of selected rows
+    size_t Evaluate(DataChunk* chunk);
+
+private:
+    enum class NodeType : uint8_t {
+        COMPARE,   // column op constant
+        BETWEEN,
+        IN_LIST,
+        AND,
+        OR,
+        NOT
+    };
+
+    // Postfix program; the mask stack holds one bitmask per open node
+    struct Node {
+        NodeType type;
+        CompareOp op;
+        uint32_t column_idx;
+        VectorType column_type;
+        Value constant;
+        Value upper;                 // BETWEEN
+        std::vector<Value> in_list;  // IN_LIST
+    };
+
+    std::vector<Node> program_;
+    std::vector<std::vector<uint64_t>> mask_stack_;
+
+    void EvaluateLeaf(const Node& node, const DataChunk& chunk, uint64_t* mask);
+};
+
+} // namespace mokshith
\ No newline at end of file
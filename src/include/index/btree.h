@@ -1,11 +1,31 @@
 #pragma once
 #include "storage/page.h"
 #include "storage/buffer_pool.h"
+#include "index/btree_node.h"
+#include "common/config.h"
+#include <atomic>
 #include <queue>
+#include <string>
+#include <type_traits>
 #include <algorithm>
 
 namespace mokshith {
 
+class LogManager;
+
+// Concurrency: optimistic lock coupling on the frame latches
+// (OptimisticLatch). Lookups and scans take no latches at all, they
+// validate node versions and restart on conflict. Insert and Remove
+// descend optimistically too and write-lock only the leaf, plus its
+// parent when the leaf must split or merge; full inner nodes met on the
+// way down are split eagerly (parent and node locked), so a split never
+// propagates upwards under a held latch.
+//
+// Node format: fixed-width KeyTypes use the InternalPage / LeafPage
+// arrays below. With KeyType = std::string (normalized VARCHAR or
+// composite keys, see KeyNormalizer) nodes are VarKeyNode pages with
+// prefix truncation, key heads for SIMD in-node search and suffix-
+// truncated separators in internal nodes.
 template <typename KeyType, typename ValueType, typename ComparatorType>
 class BPlusTree {
 public:
@@ -29,19 +49,76 @@ public:
         bool operator==(const Iterator& other) const;
         bool operator!=(const Iterator& other) const;
         
+        // Prefetch up to `num_leaves` leaves to the right of the current
+        // one: the remaining children of the parent internal page, then
+        // next_page_id of the last leaf reached
+        void SetReadAhead(size_t num_leaves) { read_ahead_leaves_ = num_leaves; }
+        
     private:
         BPlusTree* tree_;
         page_id_t page_id_;
         int index_;
         std::pair<KeyType, ValueType> current_;
+        size_t read_ahead_leaves_ = 0;
+        page_id_t prefetched_parent_id_ = INVALID_PAGE_ID;
+        
+        // Version of the leaf current_ was read from; if it changed, the
+        // iterator re-positions with Begin(current_.first)
+        uint64_t leaf_version_ = 0;
         
         void FetchCurrent();
+        void PrefetchLeaves(page_id_t parent_page_id, page_id_t next_page_id);
     };
     
     Iterator Begin();
     Iterator End();
     Iterator Begin(const KeyType& key);
     
+    // Bottom-up build of an empty tree from pairs appended in key order.
+    // Leaves are filled left to right up to fill_factor * max_size and
+    // written once; the first key of every finished node is kept so the
+    // internal levels can be built the same way, level by level, in
+    // Finish(). No splits, no random page accesses.
+    //
+    // Minimal logging: the built pages are not logged. Finish() forces
+    // them to disk and then logs a single INDEX_BUILD record with the
+    // new root, so redo never has to touch them.
+    class BulkLoader {
+    public:
+        BulkLoader(BPlusTree* tree, double fill_factor);
+        
+        // Keys must be non-decreasing; returns false if out of pages
+        bool Append(const KeyType& key, const ValueType& value);
+        // Builds the internal levels, flushes all pages and installs the
+        // root; log_manager may be null for unlogged (temporary) indexes
+        bool Finish(LogManager* log_manager, txn_id_t txn_id);
+        
+        size_t GetNumLeaves() const { return num_leaves_; }
+        size_t GetHeight() const { return height_; }
+        
+    private:
+        BPlusTree* tree_;
+        int leaf_fill_;
+        int internal_fill_;
+        Page* leaf_page_;        // leaf being filled, pinned
+        page_id_t leaf_page_id_;
+        // (first key, page id) of every finished node of the level below
+        // the one being built
+        std::vector<std::pair<KeyType, page_id_t>> level_;
+        std::vector<page_id_t> built_pages_;
+        size_t num_leaves_;
+        size_t height_;
+        
+        bool StartLeaf();
+        void FinishLeaf(page_id_t next_page_id);
+        bool BuildInternalLevel();
+    };
+    
+    // The tree must be empty
+    BulkLoader BeginBulkLoad(double fill_factor = INDEX_FILL_FACTOR) {
+        return BulkLoader(this, fill_factor);
+    }
+    
 private:
     // Node types
     enum class NodeType : uint8_t {
@@ -49,14 +126,20 @@ private:
         INTERNAL = 1
     };
     
-    // Base node structure
+    // Base node structure. parent_page_id is not maintained by
+    // concurrent splits; descents keep the path on the stack instead.
     struct BPlusTreePage {
+        page_id_t page_id;   // PageHeader prefix
+        lsn_t lsn;
         NodeType node_type;
         int size;
         int max_size;
         page_id_t parent_page_id;
-        page_id_t page_id;
     };
+    static_assert(offsetof(BPlusTreePage, lsn) == offsetof(PageHeader, lsn),
+                  "B+Tree nodes must start with PageHeader");
+    
+    static constexpr bool VARIABLE_LENGTH_KEYS = std::is_same<KeyType, std::string>::value;
     
     // Internal node
     struct InternalPage : public BPlusTreePage {
@@ -84,20 +167,46 @@ private:
     Page* FetchPage(page_id_t page_id);
     Page* NewPage(page_id_t& page_id);
     
+    // A node on the descent path, pinned, with the version it was read at
+    struct PathEntry {
+        Page* page;
+        uint64_t version;
+    };
+    
+    // Optimistic descent to the leaf that may hold `key`. Returns false
+    // (with nothing pinned or latched) if the caller must restart. For
+    // inserts, full inner nodes are split on the way down.
+    bool FindLeafOptimistic(const KeyType& key, bool split_full_inner,
+                            PathEntry* parent, PathEntry* leaf);
+    void Release(const PathEntry& entry);
+    
     bool InsertIntoLeaf(const KeyType& key, const ValueType& value, 
                        txn_id_t txn_id, LeafPage* leaf);
-    bool SplitLeaf(LeafPage* leaf, const KeyType& key, const ValueType& value);
-    bool InsertIntoParent(page_id_t old_page, const KeyType& key, 
+    // VarKeyNode counterparts, used when VARIABLE_LENGTH_KEYS. On a
+    // split, the common prefix of the new nodes' fence keys becomes
+    // their node prefix.
+    page_id_t LookupChildVar(VarKeyNode node, const KeyType& key) const;
+    bool SplitVarNode(Page* parent, Page* node_page, bool is_leaf);
+    
+    // Both split helpers run with the node and its parent write-locked
+    // (parent null for the root, which then holds root_latch_)
+    bool SplitLeaf(Page* parent, Page* leaf_page);
+    bool SplitInternal(Page* parent, Page* inner_page);
+    bool InsertIntoParent(Page* parent, page_id_t old_page, const KeyType& key, 
                          page_id_t new_page, txn_id_t txn_id);
     
+    // Runs with parent, node and the chosen sibling write-locked; the
+    // merged-away node is released with WriteUnlockObsolete
     template <typename N>
-    bool CoalesceOrRedistribute(N* node, txn_id_t txn_id);
+    bool CoalesceOrRedistribute(Page* parent, Page* node_page, txn_id_t txn_id);
     
-    page_id_t root_page_id_;
+    // Readers validate root_latch_ after loading root_page_id_; a root
+    // split or collapse write-locks it
+    std::atomic<page_id_t> root_page_id_;
+    OptimisticLatch root_latch_;
     BufferPool* buffer_pool_;
     ComparatorType comparator_;
     int max_size_;
-    std::mutex latch_;
 };
 
 } // namespace mokshith
\ No newline at end of file
@@ -0,0 +1,272 @@
+#pragma once
+#include "common/types.h"
+#include "storage/page.h"
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define MOKSHITH_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace mokshith {
+
+// Slotted B+Tree node for variable-length keys (VARCHAR and composite
+// keys in their normalized, byte-comparable form).
+//
+// Prefix truncation: the bytes shared by every key that may live in the
+// node (the common prefix of its fence keys, set at Init/split) are
+// stored once; each slot only stores the remaining suffix.
+//
+// Key heads: every slot caches the first 4 suffix bytes as a big-endian
+// uint32, so integer order on heads equals byte order on keys. Search
+// binary-searches the heads down to a small window, counts heads below
+// the search head with SSE2 compares, and only memcmps the suffixes of
+// slots whose head is equal.
+//
+// Page layout:
+// | PageHeader | Header | Slot[count] ... free ... | key suffix + value | ... | prefix |
+// Slots grow from the front, key bytes from the back.
+class VarKeyNode {
+public:
+    static constexpr size_t HEAD_SIZE = sizeof(uint32_t);
+    // Below this many candidates, search switches from binary to SIMD
+    static constexpr uint16_t SIMD_WINDOW = 16;
+
+    explicit VarKeyNode(char* data) : data_(data) {}
+
+    // Values are opaque, `value_size` bytes each (RID for leaves, child
+    // page_id_t for internal nodes)
+    void Init(const char* prefix, uint16_t prefix_length, uint16_t value_size, bool is_leaf) {
+        Header* header = GetHeader();
+        header->count = 0;
+        header->is_leaf = is_leaf ? 1 : 0;
+        header->prefix_length = prefix_length;
+        header->value_size = value_size;
+        header->fragmented_bytes = 0;
+        header->heap_start = static_cast<uint16_t>(PAGE_SIZE - prefix_length);
+        header->prefix_offset = header->heap_start;
+        std::memcpy(data_ + header->prefix_offset, prefix, prefix_length);
+    }
+
+    bool IsLeaf() const { return GetHeader()->is_leaf != 0; }
+    uint16_t GetCount() const { return GetHeader()->count; }
+    uint16_t GetPrefixLength() const { return GetHeader()->prefix_length; }
+    const char* GetPrefix() const { return data_ + GetHeader()->prefix_offset; }
+    uint16_t GetValueSize() const { return GetHeader()->value_size; }
+
+    // Free bytes, including holes left by removed keys
+    size_t GetFreeSpace() const {
+        const Header* header = GetHeader();
+        return header->heap_start - SlotsEnd() + header->fragmented_bytes;
+    }
+
+    size_t SpaceNeeded(uint16_t key_length) const {
+        return sizeof(Slot) + (key_length - GetPrefixLength()) + GetValueSize();
+    }
+
+    // Position of the first key >= key; *found is set if it is equal.
+    // `key` is the full key, including the node prefix.
+    uint16_t LowerBound(const char* key, uint16_t length, bool* found) const {
+        *found = false;
+        const Header* header = GetHeader();
+        uint16_t prefix_length = header->prefix_length;
+        int prefix_cmp = std::memcmp(key, GetPrefix(), std::min(length, prefix_length));
+        if (prefix_cmp < 0 || (prefix_cmp == 0 && length < prefix_length)) return 0;
+        if (prefix_cmp > 0) return header->count;
+
+        const char* suffix = key + prefix_length;
+        uint16_t suffix_length = length - prefix_length;
+        uint32_t head = MakeHead(suffix, suffix_length);
+
+        uint16_t lower = 0;
+        uint16_t upper = header->count;
+        while (upper - lower > SIMD_WINDOW) {
+            uint16_t mid = lower + (upper - lower) / 2;
+            if (GetSlot(mid).head < head) {
+                lower = mid + 1;
+            } else {
+                upper = mid;
+            }
+        }
+        uint16_t pos = lower + CountHeadsBelow(lower, upper, head);
+
+        // Equal heads: compare the full suffixes
+        for (; pos < header->count && GetSlot(pos).head == head; ++pos) {
+            int cmp = CompareSuffix(pos, suffix, suffix_length);
+            if (cmp >= 0) {
+                *found = cmp == 0;
+                return pos;
+            }
+        }
+        return pos;
+    }
+
+    // Inserts before the first greater key; false if the node is full
+    bool Insert(const char* key, uint16_t length, const char* value) {
+        if (SpaceNeeded(length) > GetFreeSpace()) return false;
+        if (SpaceNeeded(length) > GetHeader()->heap_start - SlotsEnd()) Compact();
+        bool found;
+        uint16_t pos = LowerBound(key, length, &found);
+        while (pos < GetCount() && found) {
+            // Duplicates go after existing equal keys
+            ++pos;
+            found = pos < GetCount() && CompareSuffix(pos, key + GetPrefixLength(),
+                                                      length - GetPrefixLength()) == 0;
+        }
+
+        Header* header = GetHeader();
+        uint16_t suffix_length = length - header->prefix_length;
+        header->heap_start -= suffix_length + header->value_size;
+        std::memcpy(data_ + header->heap_start, key + header->prefix_length, suffix_length);
+        std::memcpy(data_ + header->heap_start + suffix_length, value, header->value_size);
+
+        Slot* slots = GetSlots();
+        std::memmove(slots + pos + 1, slots + pos, (header->count - pos) * sizeof(Slot));
+        slots[pos] = Slot{header->heap_start, suffix_length,
+                          MakeHead(key + header->prefix_length, suffix_length)};
+        ++header->count;
+        return true;
+    }
+
+    void Remove(uint16_t pos) {
+        Header* header = GetHeader();
+        Slot* slots = GetSlots();
+        header->fragmented_bytes += slots[pos].length + header->value_size;
+        std::memmove(slots + pos, slots + pos + 1, (header->count - pos - 1) * sizeof(Slot));
+        --header->count;
+    }
+
+    const char* GetKeySuffix(uint16_t pos, uint16_t* length) const {
+        const Slot& slot = GetSlot(pos);
+        *length = slot.length;
+        return data_ + slot.offset;
+    }
+
+    std::string GetKey(uint16_t pos) const {
+        uint16_t length;
+        const char* suffix = GetKeySuffix(pos, &length);
+        std::string key(GetPrefix(), GetPrefixLength());
+        key.append(suffix, length);
+        return key;
+    }
+
+    const char* GetValue(uint16_t pos) const {
+        const Slot& slot = GetSlot(pos);
+        return data_ + slot.offset + slot.length;
+    }
+
+    // Rewrites the key heap without holes
+    void Compact() {
+        Header* header = GetHeader();
+        char buffer[PAGE_SIZE];
+        uint16_t heap_start = static_cast<uint16_t>(PAGE_SIZE - header->prefix_length);
+        std::memcpy(buffer + heap_start, GetPrefix(), header->prefix_length);
+        header->prefix_offset = heap_start;
+        Slot* slots = GetSlots();
+        for (uint16_t i = 0; i < header->count; ++i) {
+            uint16_t size = slots[i].length + header->value_size;
+            heap_start -= size;
+            std::memcpy(buffer + heap_start, data_ + slots[i].offset, size);
+            slots[i].offset = heap_start;
+        }
+        std::memcpy(data_ + heap_start, buffer + heap_start, PAGE_SIZE - heap_start);
+        header->heap_start = heap_start;
+        header->fragmented_bytes = 0;
+    }
+
+    static uint32_t MakeHead(const char* suffix, uint16_t length) {
+        uint32_t head = 0;
+        for (size_t i = 0; i < HEAD_SIZE; ++i) {
+            head <<= 8;
+            if (i < length) head |= static_cast<uint8_t>(suffix[i]);
+        }
+        return head;
+    }
+
+    static uint16_t CommonPrefixLength(const char* a, uint16_t a_length,
+                                       const char* b, uint16_t b_length) {
+        uint16_t limit = std::min(a_length, b_length);
+        uint16_t i = 0;
+        while (i < limit && a[i] == b[i]) ++i;
+        return i;
+    }
+
+    // Suffix truncation for splits: length of the shortest prefix of
+    // `right` (first key of the new right node) that is still greater
+    // than `left` (last key of the left node). Posting this shorter
+    // separator to the parent raises internal-node fan-out.
+    static uint16_t SeparatorLength(const char* left, uint16_t left_length,
+                                    const char* right, uint16_t right_length) {
+        uint16_t common = CommonPrefixLength(left, left_length, right, right_length);
+        return std::min<uint16_t>(common + 1, right_length);
+    }
+
+private:
+    struct Header {
+        uint16_t count;
+        uint16_t prefix_length;
+        uint16_t prefix_offset;
+        uint16_t heap_start;
+        uint16_t value_size;
+        uint16_t fragmented_bytes;
+        uint8_t is_leaf;
+        uint8_t reserved[3];
+    };
+
+    struct Slot {
+        uint16_t offset;   // of the suffix in the page
+        uint16_t length;   // suffix length
+        uint32_t head;
+    };
+
+    static constexpr size_t SLOTS_OFFSET = PAGE_HEADER_SIZE + sizeof(Header);
+
+    char* data_;
+
+    Header* GetHeader() { return reinterpret_cast<Header*>(data_ + PAGE_HEADER_SIZE); }
+    const Header* GetHeader() const { return reinterpret_cast<const Header*>(data_ + PAGE_HEADER_SIZE); }
+    Slot* GetSlots() { return reinterpret_cast<Slot*>(data_ + SLOTS_OFFSET); }
+    const Slot& GetSlot(uint16_t pos) const {
+        return reinterpret_cast<const Slot*>(data_ + SLOTS_OFFSET)[pos];
+    }
+    size_t SlotsEnd() const { return SLOTS_OFFSET + GetHeader()->count * sizeof(Slot); }
+
+    int CompareSuffix(uint16_t pos, const char* suffix, uint16_t length) const {
+        const Slot& slot = GetSlot(pos);
+        int cmp = std::memcmp(data_ + slot.offset, suffix, std::min(slot.length, length));
+        if (cmp != 0) return cmp;
+        return slot.length < length ? -1 : (slot.length > length ? 1 : 0);
+    }
+
+    // Number of slots in [lower, upper) whose head is below `head`;
+    // heads are sorted, so this is the lower bound within the window
+    uint16_t CountHeadsBelow(uint16_t lower, uint16_t upper, uint32_t head) const {
+        uint16_t pos = lower;
+        uint16_t below = 0;
+#ifdef MOKSHITH_X86_SIMD
+        // Unsigned compare via the signed one: flip the sign bits
+        const __m128i bias = _mm_set1_epi32(static_cast<int32_t>(0x80000000u));
+        const __m128i needle = _mm_xor_si128(_mm_set1_epi32(static_cast<int32_t>(head)), bias);
+        const char* slots = data_ + SLOTS_OFFSET;
+        for (; pos + 4 <= upper; pos += 4) {
+            // Four 8-byte slots; heads are the odd 32-bit lanes
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(slots + pos * sizeof(Slot)));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(slots + (pos + 2) * sizeof(Slot)));
+            __m128i heads = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b),
+                                                            _MM_SHUFFLE(3, 1, 3, 1)));
+            __m128i less = _mm_cmplt_epi32(_mm_xor_si128(heads, bias), needle);
+            int bits = _mm_movemask_ps(_mm_castsi128_ps(less));
+            below += static_cast<uint16_t>(__builtin_popcount(bits));
+            if (bits != 0xF) return below;
+        }
+#endif
+        for (; pos < upper && GetSlot(pos).head < head; ++pos) ++below;
+        return below;
+    }
+};
+
+static_assert(PAGE_SIZE <= 65536, "VarKeyNode uses 16-bit offsets");
+
+} // namespace mokshith
\ No newline at end of file
@@ -1,35 +1,626 @@
 #pragma once
 #include "storage/buffer_pool.h"
+#include "storage/page_guard.h"
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
 #include <vector>
-#include <list>
 
 namespace mokshith {
 
+// Directory of an extendible hash index, one page. Entry i points at the
+// bucket for hashes whose low global_depth bits equal i; a bucket with
+// local depth d < global_depth is shared by 2^(global_depth - d) entries.
+// It is also one segment of a larger directory (see HashRootPage); a full
+// segment sits at MAX_DEPTH and holds local depths beyond it.
+class HashDirectoryPage {
+public:
+    static constexpr uint32_t MAX_DEPTH = 9;
+    static constexpr uint32_t MAX_SIZE = 1u << MAX_DEPTH;
+
+    void Init(page_id_t first_bucket_page_id) {
+        global_depth_ = 0;
+        local_depths_[0] = 0;
+        bucket_page_ids_[0] = first_bucket_page_id;
+    }
+
+    uint32_t GetGlobalDepth() const { return global_depth_; }
+    uint32_t Size() const { return 1u << global_depth_; }
+    uint32_t GetIndex(uint64_t hash) const {
+        return static_cast<uint32_t>(hash) & (Size() - 1);
+    }
+
+    page_id_t GetBucketPageId(uint32_t index) const { return bucket_page_ids_[index]; }
+    void SetBucketPageId(uint32_t index, page_id_t page_id) { bucket_page_ids_[index] = page_id; }
+    uint32_t GetLocalDepth(uint32_t index) const { return local_depths_[index]; }
+    void SetLocalDepth(uint32_t index, uint32_t depth) {
+        local_depths_[index] = static_cast<uint8_t>(depth);
+    }
+
+    // Entry that differs from `index` only in the highest local-depth bit
+    uint32_t GetSplitImageIndex(uint32_t index) const {
+        uint32_t depth = local_depths_[index];
+        return depth == 0 ? index : index ^ (1u << (depth - 1));
+    }
+
+    // Doubles the directory; the new upper half mirrors the lower half
+    bool Grow() {
+        if (global_depth_ == MAX_DEPTH) return false;
+        uint32_t size = Size();
+        std::memcpy(bucket_page_ids_ + size, bucket_page_ids_, size * sizeof(page_id_t));
+        std::memcpy(local_depths_ + size, local_depths_, size);
+        ++global_depth_;
+        return true;
+    }
+
+    bool CanShrink() const {
+        if (global_depth_ == 0) return false;
+        for (uint32_t i = 0; i < Size(); ++i) {
+            if (local_depths_[i] == global_depth_) return false;
+        }
+        return true;
+    }
+    void Shrink() { --global_depth_; }
+
+    // Points every entry that shares bucket `index`'s low `depth` bits
+    // at `page_id`, with local depth `depth`
+    void SetBucket(uint32_t index, uint32_t depth, page_id_t page_id) {
+        uint32_t low = index & ((1u << depth) - 1);
+        for (uint32_t i = low; i < Size(); i += 1u << depth) {
+            bucket_page_ids_[i] = page_id;
+            local_depths_[i] = static_cast<uint8_t>(depth);
+        }
+    }
+
+private:
+    PageHeader page_header_;
+    uint32_t global_depth_;
+    uint8_t local_depths_[MAX_SIZE];
+    page_id_t bucket_page_ids_[MAX_SIZE];
+};
+
+static_assert(sizeof(HashDirectoryPage) <= PAGE_SIZE, "directory must fit in a page");
+
+// Root of a directory spanning several pages. Directory entry i lives in
+// segment i >> HashDirectoryPage::MAX_DEPTH, slot i & (MAX_SIZE - 1).
+// Up to HashDirectoryPage::MAX_DEPTH there is a single segment that
+// grows in place; past it every doubling copies each segment to a new
+// page, so the directory is bounded by MAX_SEGMENTS pages instead of one.
+class HashRootPage {
+public:
+    static constexpr uint32_t SEGMENT_DEPTH = HashDirectoryPage::MAX_DEPTH;
+    static constexpr uint32_t MAX_SEGMENTS = 512;
+    static constexpr uint32_t MAX_DEPTH = SEGMENT_DEPTH + 9;
+
+    void Init(page_id_t first_segment_page_id) {
+        global_depth_ = 0;
+        segment_page_ids_[0] = first_segment_page_id;
+    }
+
+    uint32_t GetGlobalDepth() const { return global_depth_; }
+    void SetGlobalDepth(uint32_t depth) { global_depth_ = depth; }
+    uint32_t Size() const { return 1u << global_depth_; }
+    uint32_t GetIndex(uint64_t hash) const {
+        return static_cast<uint32_t>(hash) & (Size() - 1);
+    }
+
+    uint32_t NumSegments() const {
+        return global_depth_ <= SEGMENT_DEPTH ? 1u : 1u << (global_depth_ - SEGMENT_DEPTH);
+    }
+    static uint32_t SegmentOf(uint32_t index) { return index >> SEGMENT_DEPTH; }
+    static uint32_t SlotOf(uint32_t index) { return index & (HashDirectoryPage::MAX_SIZE - 1); }
+
+    page_id_t GetSegmentPageId(uint32_t segment) const { return segment_page_ids_[segment]; }
+    void SetSegmentPageId(uint32_t segment, page_id_t page_id) { segment_page_ids_[segment] = page_id; }
+
+private:
+    PageHeader page_header_;
+    uint32_t global_depth_;
+    page_id_t segment_page_ids_[MAX_SEGMENTS];
+};
+
+static_assert(sizeof(HashRootPage) <= PAGE_SIZE, "root must fit in a page");
+static_assert(HashRootPage::MAX_DEPTH < 32, "directory index is 32 bits");
+
+// Outcome of HashBucketPage::Insert. Only FULL makes HashIndex split
+// the bucket; a DUPLICATE never grows the directory.
+enum class BucketInsertResult : uint8_t {
+    INSERTED,
+    DUPLICATE,
+    FULL
+};
+
+// Bucket page: a fixed array of (key, value) slots with linear probing.
+// The probe start comes from the high bits of the mixed hash (the
+// directory consumes the low bits), so a lookup touches one page and
+// usually one or two cache lines of slots. Deleted slots become
+// tombstones; the bucket counts as full at MAX_LOAD of its capacity so
+// probe sequences stay short, and tombstones are dropped when the
+// bucket is rebuilt on split.
+template <typename KeyType, typename ValueType>
+class HashBucketPage {
+public:
+    struct Entry {
+        KeyType key;
+        ValueType value;
+    };
+
+    static constexpr size_t HEADER_SIZE = PAGE_HEADER_SIZE + 2 * sizeof(uint32_t);
+    static constexpr size_t CAPACITY =
+        (PAGE_SIZE - HEADER_SIZE - alignof(Entry)) / (sizeof(Entry) + 1);
+    static constexpr size_t MAX_LOAD = CAPACITY * 7 / 8;
+
+    void Init() {
+        size_ = 0;
+        tombstones_ = 0;
+        std::memset(states_, EMPTY, sizeof(states_));
+    }
+
+    size_t Size() const { return size_; }
+    bool IsFull() const { return size_ + tombstones_ >= MAX_LOAD; }
+    bool IsEmpty() const { return size_ == 0; }
+
+    // Appends every value stored under `key`
+    void GetValue(uint64_t hash, const KeyType& key, std::vector<ValueType>& result) const {
+        for (size_t pos = Start(hash), probes = 0; probes < CAPACITY; pos = Next(pos), ++probes) {
+            if (states_[pos] == EMPTY) return;
+            if (states_[pos] == OCCUPIED && entries_[pos].key == key) {
+                result.push_back(entries_[pos].value);
+            }
+        }
+    }
+
+    // The duplicate probe runs before the capacity check, so a pair that
+    // exists reports DUPLICATE even in a full bucket. A full bucket still
+    // accepts entries that reuse a tombstone.
+    BucketInsertResult Insert(uint64_t hash, const KeyType& key, const ValueType& value) {
+        size_t target = CAPACITY;
+        for (size_t pos = Start(hash), probes = 0; probes < CAPACITY; pos = Next(pos), ++probes) {
+            if (states_[pos] == EMPTY) {
+                if (target == CAPACITY) target = pos;
+                break;
+            }
+            if (states_[pos] == TOMBSTONE) {
+                if (target == CAPACITY) target = pos;
+            } else if (entries_[pos].key == key && entries_[pos].value == value) {
+                return BucketInsertResult::DUPLICATE;
+            }
+        }
+        if (target == CAPACITY) return BucketInsertResult::FULL;
+        if (states_[target] == TOMBSTONE) {
+            --tombstones_;
+        } else if (IsFull()) {
+            return BucketInsertResult::FULL;
+        }
+        states_[target] = OCCUPIED;
+        entries_[target] = Entry{key, value};
+        ++size_;
+        return BucketInsertResult::INSERTED;
+    }
+
+    bool Remove(uint64_t hash, const KeyType& key, const ValueType& value) {
+        for (size_t pos = Start(hash), probes = 0; probes < CAPACITY; pos = Next(pos), ++probes) {
+            if (states_[pos] == EMPTY) return false;
+            if (states_[pos] == OCCUPIED && entries_[pos].key == key &&
+                entries_[pos].value == value) {
+                states_[pos] = TOMBSTONE;
+                --size_;
+                ++tombstones_;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Removes every entry under `key`; returns how many
+    size_t RemoveAll(uint64_t hash, const KeyType& key) {
+        size_t removed = 0;
+        for (size_t pos = Start(hash), probes = 0; probes < CAPACITY; pos = Next(pos), ++probes) {
+            if (states_[pos] == EMPTY) break;
+            if (states_[pos] == OCCUPIED && entries_[pos].key == key) {
+                states_[pos] = TOMBSTONE;
+                ++removed;
+            }
+        }
+        size_ -= removed;
+        tombstones_ += removed;
+        return removed;
+    }
+
+    template <typename F>
+    void ForEach(F&& f) const {
+        for (size_t pos = 0; pos < CAPACITY; ++pos) {
+            if (states_[pos] == OCCUPIED) f(entries_[pos]);
+        }
+    }
+
+private:
+    static constexpr uint8_t EMPTY = 0;
+    static constexpr uint8_t OCCUPIED = 1;
+    static constexpr uint8_t TOMBSTONE = 2;
+
+    // Multiply-shift mixing, so weak hashes (identity on integers) still
+    // spread; the high 32 bits pick the slot
+    static size_t Start(uint64_t hash) {
+        uint64_t mixed = hash * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(((mixed >> 32) * CAPACITY) >> 32);
+    }
+    static size_t Next(size_t pos) { return pos + 1 == CAPACITY ? 0 : pos + 1; }
+
+    PageHeader page_header_;
+    uint32_t size_;
+    uint32_t tombstones_;
+    uint8_t states_[CAPACITY];
+    Entry entries_[CAPACITY];
+};
+
+// Extendible hash index on buffer pool pages.
+//
+// Lookups and inserts hold directory_latch_ shared and latch only the
+// target bucket page (readers optimistically, through the frame's
+// OptimisticLatch; writers exclusively). A full bucket is split under
+// the exclusive directory latch: its local depth grows by one, the
+// directory doubles first if needed, and the entries are redistributed
+// by the new hash bit. An emptied bucket is merged into its split image
+// when both have the same local depth, and the directory halves once no
+// bucket needs its top bit.
+//
+// The directory is a root page over up to HashRootPage::MAX_SEGMENTS
+// segment pages, so it grows to 2^HashRootPage::MAX_DEPTH buckets. A
+// lookup reads the root, one segment and one bucket.
+//
+// Every structure lives on pages, so the index survives restart: reopen
+// it with the root page id recorded in the catalog.
 template <typename KeyType, typename ValueType, typename HashFunc>
 class HashIndex {
 public:
-    HashIndex(BufferPool* buffer_pool, 
+    // Opens the index at directory_page_id (its root page), or creates an
+    // empty one. Throws std::runtime_error if no frame is free for it.
+    HashIndex(BufferPool* buffer_pool,
               const HashFunc& hash_func,
-              size_t bucket_count = 1024);
-    
+              page_id_t directory_page_id = INVALID_PAGE_ID);
+
+    // False if the pair exists, or if the bucket cannot split further
+    // (more than a bucket of entries with identical hashes). Splits only
+    // when the bucket reports FULL.
     bool Insert(const KeyType& key, const ValueType& value, txn_id_t txn_id);
+    // Removes every value under `key`
     bool Remove(const KeyType& key, txn_id_t txn_id);
+    bool Remove(const KeyType& key, const ValueType& value, txn_id_t txn_id);
     bool GetValue(const KeyType& key, std::vector<ValueType>& result);
-    
+
+    page_id_t GetDirectoryPageId() const { return directory_page_id_; }
+    uint32_t GetGlobalDepth();
+
 private:
-    struct HashBucket {
-        std::list<std::pair<KeyType, ValueType>> entries;
-        std::mutex latch;
-    };
-    
+    using BucketPage = HashBucketPage<KeyType, ValueType>;
+
     BufferPool* buffer_pool_;
     HashFunc hash_func_;
-    std::vector<std::unique_ptr<HashBucket>> buckets_;
-    size_t bucket_count_;
-    
-    size_t GetBucketIndex(const KeyType& key) {
-        return hash_func_(key) % bucket_count_;
+    page_id_t directory_page_id_;
+    std::shared_mutex directory_latch_;
+
+    uint64_t Hash(const KeyType& key) const {
+        return static_cast<uint64_t>(hash_func_(key));
     }
+
+    // Bucket page and local depth of directory entry `index`; requires
+    // directory_latch_ (either mode)
+    page_id_t GetBucketPageId(const HashRootPage* root, uint32_t index, uint32_t* local_depth);
+    // Removes `key` (one pair if `value` is set) under the shared latch,
+    // then merges the bucket if that emptied it
+    bool RemoveEntries(const KeyType& key, const ValueType* value);
+
+    // The rest run with directory_latch_ held exclusively
+    bool SplitBucket(uint64_t hash);
+    void MergeBucket(uint64_t hash);
+    bool GrowDirectory(HashRootPage* root);
+    bool CanShrinkDirectory(const HashRootPage* root);
+    void ShrinkDirectory(HashRootPage* root);
+    // Points every entry sharing `index`'s low `depth` bits at `page_id`
+    void SetBucket(const HashRootPage* root, uint32_t index, uint32_t depth, page_id_t page_id);
 };
 
+template <typename KeyType, typename ValueType, typename HashFunc>
+HashIndex<KeyType, ValueType, HashFunc>::HashIndex(BufferPool* buffer_pool,
+                                                   const HashFunc& hash_func,
+                                                   page_id_t directory_page_id)
+    : buffer_pool_(buffer_pool), hash_func_(hash_func), directory_page_id_(directory_page_id) {
+    if (directory_page_id_ != INVALID_PAGE_ID) return;
+    page_id_t segment_page_id;
+    page_id_t bucket_page_id;
+    PageGuard root_guard(buffer_pool_, buffer_pool_->NewPage(directory_page_id_));
+    PageGuard segment_guard(buffer_pool_, buffer_pool_->NewPage(segment_page_id));
+    PageGuard bucket_guard(buffer_pool_, buffer_pool_->NewPage(bucket_page_id));
+    if (!root_guard.IsValid() || !segment_guard.IsValid() || !bucket_guard.IsValid()) {
+        throw std::runtime_error("HashIndex: no free frame for the directory");
+    }
+    reinterpret_cast<HashRootPage*>(root_guard.GetDataMut())->Init(segment_page_id);
+    reinterpret_cast<HashDirectoryPage*>(segment_guard.GetDataMut())->Init(bucket_page_id);
+    reinterpret_cast<BucketPage*>(bucket_guard.GetDataMut())->Init();
+}
+
+template <typename KeyType, typename ValueType, typename HashFunc>
+bool HashIndex<KeyType, ValueType, HashFunc>::Insert(const KeyType& key, const ValueType& value,
+                                                     txn_id_t /*txn_id*/) {
+    uint64_t hash = Hash(key);
+    while (true) {
+        {
+            std::shared_lock<std::shared_mutex> directory_lock(directory_latch_);
+            PageGuard root_guard = PageGuard::Fetch(buffer_pool_, directory_page_id_);
+            if (!root_guard.IsValid()) return false;
+            const auto* root = reinterpret_cast<const HashRootPage*>(root_guard.GetData());
+            uint32_t local_depth;
+            page_id_t bucket_page_id = GetBucketPageId(root, root->GetIndex(hash), &local_depth);
+            if (bucket_page_id == INVALID_PAGE_ID) return false;
+            PageGuard bucket_guard = PageGuard::Fetch(buffer_pool_, bucket_page_id);
+            if (!bucket_guard.IsValid()) return false;
+
+            OptimisticLatch& latch = bucket_guard.GetPage()->GetLatch();
+            bool restart;
+            do {
+                restart = false;
+                latch.WriteLockOrRestart(restart);
+            } while (restart);
+            auto* bucket = reinterpret_cast<BucketPage*>(bucket_guard.GetDataMut());
+            BucketInsertResult result = bucket->Insert(hash, key, value);
+            latch.WriteUnlock();
+
+            if (result == BucketInsertResult::INSERTED) return true;
+            if (result == BucketInsertResult::DUPLICATE) return false;
+        }
+        std::unique_lock<std::shared_mutex> directory_lock(directory_latch_);
+        if (!SplitBucket(hash)) return false;
+    }
+}
+
+template <typename KeyType, typename ValueType, typename HashFunc>
+bool HashIndex<KeyType, ValueType, HashFunc>::Remove(const KeyType& key, txn_id_t /*txn_id*/) {
+    return RemoveEntries(key, nullptr);
+}
+
+template <typename KeyType, typename ValueType, typename HashFunc>
+bool HashIndex<KeyType, ValueType, HashFunc>::Remove(const KeyType& key, const ValueType& value,
+                                                     txn_id_t /*txn_id*/) {
+    return RemoveEntries(key, &value);
+}
+
+template <typename KeyType, typename ValueType, typename HashFunc>
+bool HashIndex<KeyType, ValueType, HashFunc>::GetValue(const KeyType& key, std::vector<ValueType>& result) {
+    uint64_t hash = Hash(key);
+    std::shared_lock<std::shared_mutex> directory_lock(directory_latch_);
+    PageGuard root_guard = PageGuard::Fetch(buffer_pool_, directory_page_id_);
+    if (!root_guard.IsValid()) return false;
+    const auto* root = reinterpret_cast<const HashRootPage*>(root_guard.GetData());
+    uint32_t local_depth;
+    page_id_t bucket_page_id = GetBucketPageId(root, root->GetIndex(hash), &local_depth);
+    if (bucket_page_id == INVALID_PAGE_ID) return false;
+    PageGuard bucket_guard = PageGuard::Fetch(buffer_pool_, bucket_page_id);
+    if (!bucket_guard.IsValid()) return false;
+
+    const OptimisticLatch& latch = bucket_guard.GetPage()->GetLatch();
+    const auto* bucket = reinterpret_cast<const BucketPage*>(bucket_guard.GetData());
+    size_t found = result.size();
+    while (true) {
+        bool restart = false;
+        uint64_t version = latch.ReadLockOrRestart(restart);
+        if (!restart) {
+            bucket->GetValue(hash, key, result);
+            latch.CheckOrRestart(version, restart);
+        }
+        if (!restart) break;
+        result.resize(found);
+    }
+    return result.size() > found;
+}
+
+template <typename KeyType, typename ValueType, typename HashFunc>
+uint32_t HashIndex<KeyType, ValueType, HashFunc>::GetGlobalDepth() {
+    std::shared_lock<std::shared_mutex> directory_lock(directory_latch_);
+    PageGuard root_guard = PageGuard::Fetch(buffer_pool_, directory_page_id_);
+    if (!root_guard.IsValid()) return 0;
+    return reinterpret_cast<const HashRootPage*>(root_guard.GetData())->GetGlobalDepth();
+}
+
+template <typename KeyType, typename ValueType, typename HashFunc>
+page_id_t HashIndex<KeyType, ValueType, HashFunc>::GetBucketPageId(const HashRootPage* root, uint32_t index,
+                                                                   uint32_t* local_depth) {
+    PageGuard segment_guard =
+        PageGuard::Fetch(buffer_pool_, root->GetSegmentPageId(HashRootPage::SegmentOf(index)));
+    if (!segment_guard.IsValid()) {
+        *local_depth = 0;
+        return INVALID_PAGE_ID;
+    }
+    const auto* segment = reinterpret_cast<const HashDirectoryPage*>(segment_guard.GetData());
+    uint32_t slot = HashRootPage::SlotOf(index);
+    *local_depth = segment->GetLocalDepth(slot);
+    return segment->GetBucketPageId(slot);
+}
+
+template <typename KeyType, typename ValueType, typename HashFunc>
+bool HashIndex<KeyType, ValueType, HashFunc>::RemoveEntries(const KeyType& key, const ValueType* value) {
+    uint64_t hash = Hash(key);
+    bool emptied;
+    {
+        std::shared_lock<std::shared_mutex> directory_lock(directory_latch_);
+        PageGuard root_guard = PageGuard::Fetch(buffer_pool_, directory_page_id_);
+        if (!root_guard.IsValid()) return false;
+        const auto* root = reinterpret_cast<const HashRootPage*>(root_guard.GetData());
+        uint32_t local_depth;
+        page_id_t bucket_page_id = GetBucketPageId(root, root->GetIndex(hash), &local_depth);
+        if (bucket_page_id == INVALID_PAGE_ID) return false;
+        PageGuard bucket_guard = PageGuard::Fetch(buffer_pool_, bucket_page_id);
+        if (!bucket_guard.IsValid()) return false;
+
+        OptimisticLatch& latch = bucket_guard.GetPage()->GetLatch();
+        bool restart;
+        do {
+            restart = false;
+            latch.WriteLockOrRestart(restart);
+        } while (restart);
+        auto* bucket = reinterpret_cast<BucketPage*>(bucket_guard.GetDataMut());
+        bool removed = value != nullptr ? bucket->Remove(hash, key, *value) : bucket->RemoveAll(hash, key) > 0;
+        emptied = bucket->IsEmpty() && local_depth > 0;
+        latch.WriteUnlock();
+        if (!removed) return false;
+    }
+    if (emptied) {
+        std::unique_lock<std::shared_mutex> directory_lock(directory_latch_);
+        MergeBucket(hash);
+    }
+    return true;
+}
+
+template <typename KeyType, typename ValueType, typename HashFunc>
+bool HashIndex<KeyType, ValueType, HashFunc>::SplitBucket(uint64_t hash) {
+    PageGuard root_guard = PageGuard::Fetch(buffer_pool_, directory_page_id_);
+    if (!root_guard.IsValid()) return false;
+    auto* root = reinterpret_cast<HashRootPage*>(root_guard.GetDataMut());
+    uint32_t index = root->GetIndex(hash);
+    uint32_t depth;
+    page_id_t bucket_page_id = GetBucketPageId(root, index, &depth);
+    if (bucket_page_id == INVALID_PAGE_ID) return false;
+    PageGuard bucket_guard = PageGuard::Fetch(buffer_pool_, bucket_page_id);
+    if (!bucket_guard.IsValid()) return false;
+    auto* bucket = reinterpret_cast<BucketPage*>(bucket_guard.GetDataMut());
+    // Another inserter may have split it while we waited for the latch
+    if (!bucket->IsFull()) return true;
+    // No split separates entries that share the whole hash
+    bool same_hash = bucket->Size() >= BucketPage::MAX_LOAD;
+    bucket->ForEach([&](const typename BucketPage::Entry& entry) { same_hash &= Hash(entry.key) == hash; });
+    if (same_hash) return false;
+
+    if (depth == root->GetGlobalDepth() && !GrowDirectory(root)) return false;
+    page_id_t image_page_id;
+    PageGuard image_guard(buffer_pool_, buffer_pool_->NewPage(image_page_id));
+    if (!image_guard.IsValid()) return false;
+    auto* image = reinterpret_cast<BucketPage*>(image_guard.GetDataMut());
+    image->Init();
+
+    std::vector<typename BucketPage::Entry> entries;
+    entries.reserve(bucket->Size());
+    bucket->ForEach([&entries](const typename BucketPage::Entry& entry) { entries.push_back(entry); });
+    bucket->Init();
+    for (const auto& entry : entries) {
+        uint64_t entry_hash = Hash(entry.key);
+        BucketPage* target = (entry_hash >> depth) & 1 ? image : bucket;
+        target->Insert(entry_hash, entry.key, entry.value);
+    }
+
+    uint32_t low = index & ((1u << depth) - 1);
+    SetBucket(root, low, depth + 1, bucket_page_id);
+    SetBucket(root, low | (1u << depth), depth + 1, image_page_id);
+    return true;
+}
+
+template <typename KeyType, typename ValueType, typename HashFunc>
+void HashIndex<KeyType, ValueType, HashFunc>::MergeBucket(uint64_t hash) {
+    PageGuard root_guard = PageGuard::Fetch(buffer_pool_, directory_page_id_);
+    if (!root_guard.IsValid()) return;
+    auto* root = reinterpret_cast<HashRootPage*>(root_guard.GetDataMut());
+    uint32_t index = root->GetIndex(hash);
+    uint32_t depth;
+    page_id_t bucket_page_id = GetBucketPageId(root, index, &depth);
+    if (bucket_page_id == INVALID_PAGE_ID || depth == 0) return;
+    uint32_t image_index = index ^ (1u << (depth - 1));
+    uint32_t image_depth;
+    page_id_t image_page_id = GetBucketPageId(root, image_index, &image_depth);
+    if (image_depth != depth) return;
+
+    {
+        PageGuard bucket_guard = PageGuard::Fetch(buffer_pool_, bucket_page_id);
+        if (!bucket_guard.IsValid()) return;
+        // Refilled between the remove and the exclusive latch
+        if (!reinterpret_cast<const BucketPage*>(bucket_guard.GetData())->IsEmpty()) return;
+        SetBucket(root, image_index, depth - 1, image_page_id);
+        OptimisticLatch& latch = bucket_guard.GetPage()->GetLatch();
+        bool restart;
+        do {
+            restart = false;
+            latch.WriteLockOrRestart(restart);
+        } while (restart);
+        latch.WriteUnlockObsolete();
+    }
+    buffer_pool_->DeletePage(bucket_page_id);
+    while (CanShrinkDirectory(root)) ShrinkDirectory(root);
+}
+
+template <typename KeyType, typename ValueType, typename HashFunc>
+bool HashIndex<KeyType, ValueType, HashFunc>::GrowDirectory(HashRootPage* root) {
+    uint32_t depth = root->GetGlobalDepth();
+    if (depth == HashRootPage::MAX_DEPTH) return false;
+    if (depth < HashRootPage::SEGMENT_DEPTH) {
+        PageGuard segment_guard = PageGuard::Fetch(buffer_pool_, root->GetSegmentPageId(0));
+        if (!segment_guard.IsValid()) return false;
+        reinterpret_cast<HashDirectoryPage*>(segment_guard.GetDataMut())->Grow();
+        root->SetGlobalDepth(depth + 1);
+        return true;
+    }
+    // The new upper half of the directory mirrors the lower half, one
+    // segment page at a time
+    uint32_t segments = root->NumSegments();
+    std::vector<page_id_t> copies;
+    for (uint32_t i = 0; i < segments; ++i) {
+        PageGuard segment_guard = PageGuard::Fetch(buffer_pool_, root->GetSegmentPageId(i));
+        page_id_t copy_page_id;
+        PageGuard copy_guard(buffer_pool_, segment_guard.IsValid() ? buffer_pool_->NewPage(copy_page_id) : nullptr);
+        if (!copy_guard.IsValid()) {
+            for (page_id_t page_id : copies) buffer_pool_->DeletePage(page_id);
+            return false;
+        }
+        std::memcpy(copy_guard.GetDataMut() + PAGE_HEADER_SIZE, segment_guard.GetData() + PAGE_HEADER_SIZE,
+                    PAGE_SIZE - PAGE_HEADER_SIZE);
+        copies.push_back(copy_page_id);
+    }
+    for (uint32_t i = 0; i < segments; ++i) root->SetSegmentPageId(segments + i, copies[i]);
+    root->SetGlobalDepth(depth + 1);
+    return true;
+}
+
+template <typename KeyType, typename ValueType, typename HashFunc>
+bool HashIndex<KeyType, ValueType, HashFunc>::CanShrinkDirectory(const HashRootPage* root) {
+    uint32_t depth = root->GetGlobalDepth();
+    if (depth == 0) return false;
+    for (uint32_t i = 0; i < root->NumSegments(); ++i) {
+        PageGuard segment_guard = PageGuard::Fetch(buffer_pool_, root->GetSegmentPageId(i));
+        if (!segment_guard.IsValid()) return false;
+        const auto* segment = reinterpret_cast<const HashDirectoryPage*>(segment_guard.GetData());
+        for (uint32_t slot = 0; slot < segment->Size(); ++slot) {
+            if (segment->GetLocalDepth(slot) == depth) return false;
+        }
+    }
+    return true;
+}
+
+template <typename KeyType, typename ValueType, typename HashFunc>
+void HashIndex<KeyType, ValueType, HashFunc>::ShrinkDirectory(HashRootPage* root) {
+    uint32_t depth = root->GetGlobalDepth();
+    if (depth <= HashRootPage::SEGMENT_DEPTH) {
+        PageGuard segment_guard = PageGuard::Fetch(buffer_pool_, root->GetSegmentPageId(0));
+        if (!segment_guard.IsValid()) return;
+        reinterpret_cast<HashDirectoryPage*>(segment_guard.GetDataMut())->Shrink();
+    } else {
+        // The upper half mirrors the lower half again
+        uint32_t half = root->NumSegments() / 2;
+        for (uint32_t i = half; i < 2 * half; ++i) buffer_pool_->DeletePage(root->GetSegmentPageId(i));
+    }
+    root->SetGlobalDepth(depth - 1);
+}
+
+template <typename KeyType, typename ValueType, typename HashFunc>
+void HashIndex<KeyType, ValueType, HashFunc>::SetBucket(const HashRootPage* root, uint32_t index,
+                                                        uint32_t depth, page_id_t page_id) {
+    // Up to SEGMENT_DEPTH the matching entries repeat in every segment;
+    // past it they are one slot in every 2^(depth - SEGMENT_DEPTH)-th
+    uint32_t low = index & ((1u << depth) - 1);
+    uint32_t step = depth <= HashRootPage::SEGMENT_DEPTH ? 1u : 1u << (depth - HashRootPage::SEGMENT_DEPTH);
+    for (uint32_t i = HashRootPage::SegmentOf(low); i < root->NumSegments(); i += step) {
+        PageGuard segment_guard = PageGuard::Fetch(buffer_pool_, root->GetSegmentPageId(i));
+        if (!segment_guard.IsValid()) continue;
+        auto* segment = reinterpret_cast<HashDirectoryPage*>(segment_guard.GetDataMut());
+        segment->SetBucket(HashRootPage::SlotOf(low), depth, page_id);
+    }
+}
+
 } // namespace mokshith
\ No newline at end of file
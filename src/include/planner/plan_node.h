@@ -6,6 +6,8 @@
 
 namespace mokshith {
 
+class CompiledExpression;
+
 enum class PlanType {
     INVALID = 0,
     SEQ_SCAN,
@@ -17,7 +19,11 @@ enum class PlanType {
     HASH_JOIN,
     AGGREGATE,
     LIMIT,
-    PROJECTION
+    PROJECTION,
+    FILTER,
+    GATHER,
+    SORT,
+    TOP_N
 };
 
 class PlanNode {
@@ -61,11 +67,26 @@ public:
     oid_t GetTableOid() const { return table_oid_; }
     const Expression* GetPredicate() const { return predicate_; }
     
+    // Columns referenced by the output schema and predicate. Empty means
+    // all columns; PAX tables only read the listed columns.
+    const std::vector<uint32_t>& GetProjectedColumns() const { return projected_columns_; }
+    void SetProjectedColumns(std::vector<uint32_t> column_ids) {
+        projected_columns_ = std::move(column_ids);
+    }
+    
+    // Set by ExpressionCompiler::CompilePlan; null means interpret predicate_
+    const CompiledExpression* GetCompiledPredicate() const { return compiled_predicate_.get(); }
+    void SetCompiledPredicate(std::shared_ptr<CompiledExpression> compiled) {
+        compiled_predicate_ = std::move(compiled);
+    }
+    
 private:
     std::string table_name_;
     std::string table_alias_;
     oid_t table_oid_;
     const Expression* predicate_;
+    std::vector<uint32_t> projected_columns_;
+    std::shared_ptr<CompiledExpression> compiled_predicate_;
 };
 
 class InsertPlan : public PlanNode {
@@ -88,4 +109,233 @@ private:
     std::vector<std::vector<Value>> values_;
 };
 
+class FilterPlan : public PlanNode {
+public:
+    FilterPlan(std::shared_ptr<Schema> output_schema,
+               std::shared_ptr<PlanNode> child,
+               const Expression* predicate)
+        : PlanNode(PlanType::FILTER, output_schema),
+          predicate_(predicate) {
+        AddChild(child);
+    }
+    
+    const Expression* GetPredicate() const { return predicate_; }
+    
+    const CompiledExpression* GetCompiledPredicate() const { return compiled_predicate_.get(); }
+    void SetCompiledPredicate(std::shared_ptr<CompiledExpression> compiled) {
+        compiled_predicate_ = std::move(compiled);
+    }
+    
+private:
+    const Expression* predicate_;
+    std::shared_ptr<CompiledExpression> compiled_predicate_;
+};
+
+class ProjectionPlan : public PlanNode {
+public:
+    ProjectionPlan(std::shared_ptr<Schema> output_schema,
+                   std::shared_ptr<PlanNode> child,
+                   std::vector<const Expression*> expressions)
+        : PlanNode(PlanType::PROJECTION, output_schema),
+          expressions_(std::move(expressions)) {
+        AddChild(child);
+    }
+    
+    const std::vector<const Expression*>& GetExpressions() const { return expressions_; }
+    
+    // One entry per expression, null entries are interpreted
+    const std::vector<std::shared_ptr<CompiledExpression>>& GetCompiledExpressions() const {
+        return compiled_expressions_;
+    }
+    void SetCompiledExpressions(std::vector<std::shared_ptr<CompiledExpression>> compiled) {
+        compiled_expressions_ = std::move(compiled);
+    }
+    
+private:
+    std::vector<const Expression*> expressions_;
+    std::vector<std::shared_ptr<CompiledExpression>> compiled_expressions_;
+};
+
+// Root of a parallel pipeline: its single child (scan, optionally under
+// a filter and projection) runs on `parallel_degree` workers
+class GatherPlan : public PlanNode {
+public:
+    GatherPlan(std::shared_ptr<Schema> output_schema,
+               std::shared_ptr<PlanNode> child,
+               size_t parallel_degree,
+               size_t morsel_pages)
+        : PlanNode(PlanType::GATHER, output_schema),
+          parallel_degree_(parallel_degree),
+          morsel_pages_(morsel_pages) {
+        AddChild(child);
+    }
+    
+    size_t GetParallelDegree() const { return parallel_degree_; }
+    size_t GetMorselPages() const { return morsel_pages_; }
+    
+private:
+    size_t parallel_degree_;
+    size_t morsel_pages_;
+};
+
+// Equi-join; children are [build (left), probe (right)]. The optimizer
+// puts the smaller input on the build side.
+class HashJoinPlan : public PlanNode {
+public:
+    HashJoinPlan(std::shared_ptr<Schema> output_schema,
+                 std::shared_ptr<PlanNode> build_child,
+                 std::shared_ptr<PlanNode> probe_child,
+                 std::vector<const Expression*> build_keys,
+                 std::vector<const Expression*> probe_keys,
+                 const Expression* residual_predicate)
+        : PlanNode(PlanType::HASH_JOIN, output_schema),
+          build_keys_(std::move(build_keys)),
+          probe_keys_(std::move(probe_keys)),
+          residual_predicate_(residual_predicate) {
+        AddChild(build_child);
+        AddChild(probe_child);
+    }
+    
+    const std::vector<const Expression*>& GetBuildKeys() const { return build_keys_; }
+    const std::vector<const Expression*>& GetProbeKeys() const { return probe_keys_; }
+    const Expression* GetResidualPredicate() const { return residual_predicate_; }
+    
+    // Compiled key expressions, set by ExpressionCompiler::CompilePlan
+    const std::vector<std::shared_ptr<CompiledExpression>>& GetCompiledBuildKeys() const {
+        return compiled_build_keys_;
+    }
+    const std::vector<std::shared_ptr<CompiledExpression>>& GetCompiledProbeKeys() const {
+        return compiled_probe_keys_;
+    }
+    void SetCompiledKeys(std::vector<std::shared_ptr<CompiledExpression>> build,
+                         std::vector<std::shared_ptr<CompiledExpression>> probe) {
+        compiled_build_keys_ = std::move(build);
+        compiled_probe_keys_ = std::move(probe);
+    }
+    
+    // Optimizer's estimate, used to pick the number of radix bits up front
+    size_t GetEstimatedBuildRows() const { return estimated_build_rows_; }
+    void SetEstimatedBuildRows(size_t rows) { estimated_build_rows_ = rows; }
+    
+private:
+    std::vector<const Expression*> build_keys_;
+    std::vector<const Expression*> probe_keys_;
+    const Expression* residual_predicate_;
+    std::vector<std::shared_ptr<CompiledExpression>> compiled_build_keys_;
+    std::vector<std::shared_ptr<CompiledExpression>> compiled_probe_keys_;
+    size_t estimated_build_rows_ = 0;
+};
+
+enum class AggregateType : uint8_t {
+    COUNT_STAR,
+    COUNT,
+    SUM,
+    AVG,
+    MIN,
+    MAX
+};
+
+struct AggregateExpression {
+    AggregateType type;
+    const Expression* argument;  // null for COUNT(*)
+};
+
+// GROUP BY; output is the group-by columns followed by the aggregates
+class AggregatePlan : public PlanNode {
+public:
+    AggregatePlan(std::shared_ptr<Schema> output_schema,
+                  std::shared_ptr<PlanNode> child,
+                  std::vector<const Expression*> group_by,
+                  std::vector<AggregateExpression> aggregates,
+                  const Expression* having)
+        : PlanNode(PlanType::AGGREGATE, output_schema),
+          group_by_(std::move(group_by)),
+          aggregates_(std::move(aggregates)),
+          having_(having) {
+        AddChild(child);
+    }
+    
+    const std::vector<const Expression*>& GetGroupBy() const { return group_by_; }
+    const std::vector<AggregateExpression>& GetAggregates() const { return aggregates_; }
+    const Expression* GetHaving() const { return having_; }
+    
+    // Estimated distinct groups, 0 if unknown
+    size_t GetEstimatedGroups() const { return estimated_groups_; }
+    void SetEstimatedGroups(size_t groups) { estimated_groups_ = groups; }
+    
+private:
+    std::vector<const Expression*> group_by_;
+    std::vector<AggregateExpression> aggregates_;
+    const Expression* having_;
+    size_t estimated_groups_ = 0;
+};
+
+struct OrderByExpression {
+    const Expression* expression;
+    bool descending;
+    bool nulls_first;
+};
+
+class SortPlan : public PlanNode {
+public:
+    SortPlan(std::shared_ptr<Schema> output_schema,
+             std::shared_ptr<PlanNode> child,
+             std::vector<OrderByExpression> order_bys)
+        : PlanNode(PlanType::SORT, output_schema),
+          order_bys_(std::move(order_bys)) {
+        AddChild(child);
+    }
+    
+    const std::vector<OrderByExpression>& GetOrderBys() const { return order_bys_; }
+    
+private:
+    std::vector<OrderByExpression> order_bys_;
+};
+
+class LimitPlan : public PlanNode {
+public:
+    LimitPlan(std::shared_ptr<Schema> output_schema,
+              std::shared_ptr<PlanNode> child,
+              size_t limit,
+              size_t offset)
+        : PlanNode(PlanType::LIMIT, output_schema),
+          limit_(limit),
+          offset_(offset) {
+        AddChild(child);
+    }
+    
+    size_t GetLimit() const { return limit_; }
+    size_t GetOffset() const { return offset_; }
+    
+private:
+    size_t limit_;
+    size_t offset_;
+};
+
+// ORDER BY ... LIMIT; produced by the optimizer from Limit over Sort.
+// Keeps only limit + offset rows in a bounded heap.
+class TopNPlan : public PlanNode {
+public:
+    TopNPlan(std::shared_ptr<Schema> output_schema,
+             std::shared_ptr<PlanNode> child,
+             std::vector<OrderByExpression> order_bys,
+             size_t limit,
+             size_t offset)
+        : PlanNode(PlanType::TOP_N, output_schema),
+          order_bys_(std::move(order_bys)),
+          limit_(limit),
+          offset_(offset) {
+        AddChild(child);
+    }
+    
+    const std::vector<OrderByExpression>& GetOrderBys() const { return order_bys_; }
+    size_t GetLimit() const { return limit_; }
+    size_t GetOffset() const { return offset_; }
+    
+private:
+    std::vector<OrderByExpression> order_bys_;
+    size_t limit_;
+    size_t offset_;
+};
+
 } // namespace mokshith
\ No newline at end of file
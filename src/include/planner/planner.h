@@ -2,6 +2,7 @@
 #include "parser/ast.h"
 #include "planner/plan_node.h"
 #include "catalog/catalog.h"
+#include "common/config.h"
 
 namespace mokshith {
 
@@ -27,6 +28,8 @@ public:
     explicit Optimizer(Catalog* catalog) : catalog_(catalog) {}
     
     std::shared_ptr<PlanNode> Optimize(std::shared_ptr<PlanNode> plan);
+    std::shared_ptr<PlanNode> Optimize(std::shared_ptr<PlanNode> plan,
+                                       const SessionSettings& settings);
     
 private:
     Catalog* catalog_;
@@ -35,6 +38,15 @@ private:
     std::shared_ptr<PlanNode> PushDownPredicate(std::shared_ptr<PlanNode> plan);
     std::shared_ptr<PlanNode> ChooseJoinAlgorithm(std::shared_ptr<PlanNode> plan);
     std::shared_ptr<PlanNode> UseIndexIfAvailable(std::shared_ptr<PlanNode> plan);
+    std::shared_ptr<PlanNode> PruneScanColumns(std::shared_ptr<PlanNode> plan);
+    // Limit over Sort becomes a TopNPlan when limit + offset rows fit
+    // in work_mem
+    std::shared_ptr<PlanNode> RewriteTopN(std::shared_ptr<PlanNode> plan,
+                                          const SessionSettings& settings);
+    // Wraps scan [-> filter] [-> projection] chains over tables larger
+    // than a few morsels in a GatherPlan when max_parallel_workers > 1
+    std::shared_ptr<PlanNode> ParallelizeScans(std::shared_ptr<PlanNode> plan,
+                                               const SessionSettings& settings);
 };
 
 } // namespace mokshith
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+#include "storage/buffer_pool.h"
+#include "storage/disk_manager.h"
+#include "transaction/log_manager.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mokshith {
+
+struct BackgroundWriterConfig {
+    size_t clean_target = BUFFER_POOL_SIZE / 4;  // clean evictable frames to keep ready
+    size_t max_pages_per_round = 64;
+    size_t max_coalesce_pages = 16;               // pages per contiguous write
+    uint32_t interval_ms = 50;
+};
+
+struct BackgroundWriterStats {
+    uint64_t rounds;
+    uint64_t pages_written;
+    uint64_t writes_issued;       // after coalescing adjacent pages
+    uint64_t skipped_wal;         // page LSN > persistent LSN
+    uint64_t skipped_redirtied;   // modified again while being written
+};
+
+// Keeps a pool of clean, evictable frames so that eviction does not
+// put a synchronous DiskManager::WritePage on a query's critical path.
+//
+// Each round snapshots up to max_pages_per_round dirty, unpinned frames
+// near the eviction end of the replacer, sorts them by page_id_t and
+// issues runs of adjacent pages as single WritePagesAsync calls. A page
+// whose LSN is past LogManager's persistent LSN is skipped (WAL rule).
+// A frame is only marked clean if it was not re-dirtied during the write.
+class BackgroundWriter {
+public:
+    BackgroundWriter(BufferPool* buffer_pool,
+                     DiskManager* disk_manager,
+                     LogManager* log_manager,
+                     const BackgroundWriterConfig& config = BackgroundWriterConfig());
+    ~BackgroundWriter();
+
+    void Start();
+    void Stop();
+
+    // Called by BufferPool when a victim frame had to be written inline
+    void Wakeup();
+
+    // Runs one round synchronously, returns the number of pages written
+    size_t RunOnce();
+
+    BackgroundWriterStats GetStats() const;
+
+private:
+    BufferPool* buffer_pool_;
+    DiskManager* disk_manager_;
+    LogManager* log_manager_;
+    BackgroundWriterConfig config_;
+
+    std::thread* writer_thread_;
+    std::atomic<bool> running_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool wakeup_requested_;
+
+    // Reused across rounds; max_pages_per_round pages, aligned for O_DIRECT
+    AlignedPageBuffer staging_buffer_;
+
+    std::atomic<uint64_t> rounds_;
+    std::atomic<uint64_t> pages_written_;
+    std::atomic<uint64_t> writes_issued_;
+    std::atomic<uint64_t> skipped_wal_;
+    std::atomic<uint64_t> skipped_redirtied_;
+
+    void RunWriterThread();
+};
+
+} // namespace mokshith
\ No newline at end of file
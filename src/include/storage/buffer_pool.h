@@ -1,59 +1,231 @@
 #pragma once
 #include "storage/page.h"
 #include "storage/disk_manager.h"
+#include "storage/replacer.h"
+#include "storage/page_table.h"
 #include "common/types.h"
-#include <unordered_map>
+#include "common/config.h"
 #include <list>
 #include <mutex>
 #include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
 
 namespace mokshith {
 
+class BackgroundWriter;
+class LogManager;
+
+struct BufferPoolStats {
+    ReplacerType replacer_type;
+    uint64_t hits;
+    uint64_t latch_free_hits;   // subset of hits served without the shard latch
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t ring_hits;      // SEQUENTIAL fetches served from the scan ring
+    uint64_t ring_misses;
+    uint64_t prefetch_issued;   // pages read by PrefetchPages
+    uint64_t prefetch_hits;     // first FetchPage of a prefetched page
+    uint64_t dirty_evictions;   // victims written inline by the fetching thread
+    
+    double HitRate() const {
+        uint64_t total = hits + misses;
+        return total == 0 ? 0.0 : static_cast<double>(hits) / total;
+    }
+};
+
 class BufferPool {
 public:
-    BufferPool(size_t pool_size, DiskManager* disk_manager);
+    // num_shards is clamped so every shard keeps at least
+    // MIN_FRAMES_PER_SHARD frames
+    BufferPool(size_t pool_size, DiskManager* disk_manager,
+               size_t num_shards = BUFFER_POOL_SHARDS,
+               ReplacerType replacer_type = ReplacerType::LRU);
     ~BufferPool();
     
     // Page operations
-    Page* FetchPage(page_id_t page_id);
+    // Hits take no latch: the frame is found in the shard's
+    // ConcurrentPageTable, pinned with an atomic increment and validated
+    // afterwards. Only misses, evictions and failed validations take the
+    // shard latch. UnpinPage is latch-free as well.
+    // SEQUENTIAL misses are loaded into a small per-pool ring of frames
+    // instead of the main pool, so a large scan cannot flush the hot set
+    Page* FetchPage(page_id_t page_id, AccessType access_type = AccessType::RANDOM);
     bool UnpinPage(page_id_t page_id, bool is_dirty);
     bool FlushPage(page_id_t page_id);
     Page* NewPage(page_id_t& page_id);
     bool DeletePage(page_id_t page_id);
     void FlushAllPages();
     
+    // Asynchronously load pages that are not resident, without pinning
+    // them. Returns immediately; a FetchPage that races the read waits on
+    // the frame's io_in_progress. Skips pages that are already resident
+    // or would require evicting a dirty frame.
+    size_t PrefetchPages(page_id_t first_page_id, size_t num_pages,
+                         AccessType access_type = AccessType::SEQUENTIAL);
+    size_t PrefetchPages(const std::vector<page_id_t>& page_ids,
+                         AccessType access_type = AccessType::RANDOM);
+    
+    // Write-back is gated on log durability: a dirty frame is never
+    // written while its page LSN is past the log's persistent LSN
+    void SetLogManager(LogManager* log_manager) { log_manager_ = log_manager; }
+    void SetBackgroundWriter(BackgroundWriter* bg_writer) { bg_writer_ = bg_writer; }
+    
+    size_t GetPoolSize() const { return pool_size_; }
+    size_t GetNumShards() const { return shards_.size(); }
+    ReplacerType GetReplacerType() const { return replacer_type_; }
+    BufferPoolStats GetStats() const;
+    void ResetStats();
+    
 private:
+    friend class BackgroundWriter;
+    
+    static constexpr size_t MIN_FRAMES_PER_SHARD = 16;
+    
+    // pin_count is EVICTING while a victim is being reassigned: the
+    // evictor claims an unpinned frame with CAS(0 -> EVICTING), so a
+    // latch-free pin that sees a negative count backs off. page_id is
+    // re-checked after pinning because the frame may have been reused
+    // between the page table lookup and the increment. Reassigning a
+    // frame (NewPage, a miss, a ring recycle) goes through Page::Init,
+    // which also resets the frame's optimistic latch.
+    static constexpr int EVICTING = -(1 << 30);
+    
     struct Frame {
+        explicit Frame(char* data)
+            : page(data), page_id(INVALID_PAGE_ID), pin_count(0), is_dirty(false),
+              io_in_progress(false), prefetched(false), dirty_version(0), referenced(false) {}
+        
         Page page;
-        page_id_t page_id;
+        std::atomic<page_id_t> page_id;
         std::atomic<int> pin_count;
-        bool is_dirty;
+        std::atomic<bool> is_dirty;
+        std::atomic<bool> io_in_progress;  // read/write-back in flight, wait on shard io_cv
+        // Loaded by PrefetchPages, not fetched yet. Cleared by the first
+        // fetch, which may be a latch-free hit
+        std::atomic<bool> prefetched;
+        std::atomic<uint64_t> dirty_version;  // bumped on every dirty unpin
+        // Set by latch-free hits, which cannot call into the replacer.
+        // GetVictimFrame gives referenced frames a second chance and
+        // replays the access to the replacer.
+        std::atomic<bool> referenced;
     };
     
-    // LRU eviction
-    class LRUReplacer {
-    public:
-        explicit LRUReplacer(size_t num_pages);
-        bool Victim(frame_id_t* frame_id);
-        void Pin(frame_id_t frame_id);
-        void Unpin(frame_id_t frame_id);
-        size_t Size();
+    // A page lives in exactly one shard, chosen by hashing its page_id.
+    // Each shard owns a contiguous slice of frames_ and its own latch,
+    // page table, free list and replacer; num_shards = 1 is the classic
+    // single-latch pool. The replacer sees shard-local frame ids
+    // (frame_id - first_frame).
+    struct Shard {
+        Shard(frame_id_t first_frame, size_t num_frames, ReplacerType replacer_type);
         
-    private:
-        std::mutex mutex_;
-        std::list<frame_id_t> lru_list_;
-        std::unordered_map<frame_id_t, std::list<frame_id_t>::iterator> lru_map_;
+        frame_id_t first_frame;
+        size_t num_frames;
+        ConcurrentPageTable page_table;  // written under latch, read without
+        std::list<frame_id_t> free_list;
+        std::unique_ptr<Replacer> replacer;
+        std::mutex latch;
+        std::condition_variable io_cv;
     };
     
     size_t pool_size_;
+    // Frame metadata and page bytes are allocated apart: page_arena_ is
+    // one PAGE_SIZE-aligned block of pool_size_ pages, frame i's page
+    // uses slot i, and frames_ stays densely packed. Both from
+    // AllocateFrames.
+    AlignedPageBuffer page_arena_;
     Frame* frames_;
     DiskManager* disk_manager_;
-    std::unordered_map<page_id_t, frame_id_t> page_table_;
-    std::list<frame_id_t> free_list_;
-    LRUReplacer* replacer_;
-    std::mutex latch_;
+    LogManager* log_manager_;
+    BackgroundWriter* bg_writer_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    ReplacerType replacer_type_;
+    
+    // Scan ring: the last SCAN_RING_SIZE frames of frames_, recycled
+    // round-robin by SEQUENTIAL misses. Ring pages are still registered
+    // in their shard's page table so RANDOM fetches find them. The ring
+    // is empty for pools smaller than 4 * SCAN_RING_SIZE.
+    struct ScanRing {
+        std::vector<frame_id_t> frames;
+        size_t next;
+        std::mutex latch;
+    };
+    ScanRing scan_ring_;
+    
+    std::atomic<uint64_t> hits_;
+    std::atomic<uint64_t> latch_free_hits_;
+    std::atomic<uint64_t> misses_;
+    std::atomic<uint64_t> evictions_;
+    std::atomic<uint64_t> ring_hits_;
+    std::atomic<uint64_t> ring_misses_;
+    std::atomic<uint64_t> prefetch_issued_;
+    std::atomic<uint64_t> prefetch_hits_;
+    std::atomic<uint64_t> dirty_evictions_;
+    
+    Shard& GetShard(page_id_t page_id) {
+        // Fibonacci hashing spreads sequential page ids across shards
+        uint32_t h = static_cast<uint32_t>(page_id) * 2654435769u;
+        return *shards_[(h >> 16) % shards_.size()];
+    }
     
-    frame_id_t GetVictimFrame();
+    // Hit path without the shard latch; nullptr means take the latched
+    // path (miss, frame being evicted or loaded, or a lost race)
+    Page* TryFetchLatchFree(Shard& shard, page_id_t page_id);
+    // Claims an evictable frame of the shard (pin_count EVICTING), writes
+    // it back if dirty and unmaps its page. Skips frames whose page LSN is
+    // not durable yet, and dirty frames unless allow_dirty. -1 if none.
+    frame_id_t GetVictimFrame(Shard& shard, bool allow_dirty = true);
+    // Same for the next ring frame; takes the ring latch and then the
+    // latch of the shard owning the frame's page, so callers hold no
+    // shard latch
+    frame_id_t GetRingFrame();
+    bool IsRingFrame(frame_id_t frame_id) const {
+        return frame_id >= static_cast<frame_id_t>(pool_size_ - scan_ring_.frames.size());
+    }
+    
+    // Misses read with the shard latch released, so many reads can be in
+    // flight at once; io_in_progress marks the frame and waiters sleep on
+    // the shard's io_cv. Prefetches and FlushAllPages use DiskManager's
+    // async API. A miss reports the loaded page to the shard's replacer
+    // through RecordPageLoad before the first RecordAccess.
+    static Frame* AllocateFrames(size_t num_frames, AlignedPageBuffer* arena) {
+        char* data = static_cast<char*>(std::aligned_alloc(PAGE_SIZE, num_frames * PAGE_SIZE));
+        if (data == nullptr) throw std::bad_alloc();
+        arena->reset(data);
+        Frame* frames = static_cast<Frame*>(::operator new(num_frames * sizeof(Frame)));
+        for (size_t i = 0; i < num_frames; ++i) new (&frames[i]) Frame(data + i * PAGE_SIZE);
+        return frames;
+    }
+    static void FreeFrames(Frame* frames, size_t num_frames) {
+        for (size_t i = 0; i < num_frames; ++i) frames[i].~Frame();
+        ::operator delete(frames);
+    }
+    
+    // Maps page_id to the claimed frame_id in its shard (latch held)
+    void InstallPage(Shard& shard, frame_id_t frame_id, page_id_t page_id);
+    void ReadFrame(Shard& shard, std::unique_lock<std::mutex>& lock, frame_id_t frame_id);
+    void WaitForFrameIO(Shard& shard, std::unique_lock<std::mutex>& lock, frame_id_t frame_id);
+    void WriteBackFrames(const std::vector<frame_id_t>& frame_ids);
+    
+    // Background writer interface. CollectDirtyFrames copies up to
+    // max_frames dirty, unpinned frames whose page LSN is durable into
+    // `buffer` in page_id order, preferring frames no latch-free hit has
+    // referenced since the last eviction sweep.
+    struct DirtyFrameSnapshot {
+        frame_id_t frame_id;
+        page_id_t page_id;
+        uint64_t dirty_version;
+        char* data;  // points into the caller's buffer
+    };
+    size_t CollectDirtyFrames(size_t max_frames, char* buffer,
+                              std::vector<DirtyFrameSnapshot>* snapshots,
+                              size_t* skipped_wal);
+    // Clears is_dirty unless the frame was re-dirtied since the snapshot
+    bool MarkFrameClean(const DirtyFrameSnapshot& snapshot);
+    size_t NumCleanEvictable();
 };
 
 } // namespace mokshith
\ No newline at end of file
@@ -0,0 +1,210 @@
+#pragma once
+#include "common/types.h"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace mokshith {
+
+// Lightweight, dependency-free column encodings for PAX minipages.
+// The encoding is picked per minipage when the page is sealed, and scans
+// evaluate simple predicates on the encoded form, producing a selection
+// vector of matching row numbers.
+enum class EncodingType : uint8_t {
+    PLAIN = 0,
+    DICTIONARY,       // VARCHAR: sorted dictionary + bit-packed codes
+    RLE,              // (value, run length) pairs
+    FOR_BITPACK       // INT: frame of reference + bit-packing
+};
+
+// Bit-packs unsigned values with a fixed bit width, LSB first
+class BitPacker {
+public:
+    static uint32_t BitsRequired(uint64_t max_value) {
+        uint32_t bits = 0;
+        while (max_value != 0) {
+            ++bits;
+            max_value >>= 1;
+        }
+        return bits;
+    }
+
+    static size_t PackedSize(size_t count, uint32_t bit_width) {
+        return (count * bit_width + 7) / 8;
+    }
+
+    // `out` must hold PackedSize(count, bit_width) + 8 bytes
+    static void Pack(const uint32_t* values, size_t count, uint32_t bit_width, uint8_t* out) {
+        std::memset(out, 0, PackedSize(count, bit_width) + 8);
+        if (bit_width == 0) return;
+        for (size_t i = 0; i < count; ++i) {
+            size_t bit = i * bit_width;
+            uint64_t word;
+            std::memcpy(&word, out + bit / 8, sizeof(word));
+            word |= static_cast<uint64_t>(values[i]) << (bit % 8);
+            std::memcpy(out + bit / 8, &word, sizeof(word));
+        }
+    }
+
+    static uint32_t Get(const uint8_t* in, size_t index, uint32_t bit_width) {
+        if (bit_width == 0) return 0;
+        size_t bit = index * bit_width;
+        uint64_t word;
+        std::memcpy(&word, in + bit / 8, sizeof(word));
+        return static_cast<uint32_t>((word >> (bit % 8)) & ((uint64_t(1) << bit_width) - 1));
+    }
+
+    static void Unpack(const uint8_t* in, size_t count, uint32_t bit_width, uint32_t* out) {
+        for (size_t i = 0; i < count; ++i) out[i] = Get(in, i, bit_width);
+    }
+};
+
+// Frame of reference over int32: stores min(values) and the bit-packed
+// deltas. Comparisons are rewritten to the delta domain, so a predicate
+// never decodes a value.
+class FrameOfReference {
+public:
+    struct Header {
+        int32_t base;
+        uint32_t count;
+        uint32_t bit_width;
+    };
+
+    static size_t EncodedSize(const int32_t* values, size_t count) {
+        Header header = MakeHeader(values, count);
+        return sizeof(Header) + BitPacker::PackedSize(count, header.bit_width) + 8;
+    }
+
+    static size_t Encode(const int32_t* values, size_t count, uint8_t* out) {
+        Header header = MakeHeader(values, count);
+        std::memcpy(out, &header, sizeof(header));
+        std::vector<uint32_t> deltas(count);
+        for (size_t i = 0; i < count; ++i) {
+            deltas[i] = static_cast<uint32_t>(static_cast<int64_t>(values[i]) - header.base);
+        }
+        BitPacker::Pack(deltas.data(), count, header.bit_width, out + sizeof(Header));
+        return sizeof(Header) + BitPacker::PackedSize(count, header.bit_width) + 8;
+    }
+
+    static int32_t Get(const uint8_t* in, size_t index) {
+        Header header;
+        std::memcpy(&header, in, sizeof(header));
+        return static_cast<int32_t>(header.base +
+            static_cast<int64_t>(BitPacker::Get(in + sizeof(Header), index, header.bit_width)));
+    }
+
+    // Appends the row numbers (offset by row_base) of values satisfying
+    // `value op constant` to *selection
+    static void Select(const uint8_t* in, CompareOp op, int32_t constant,
+                       uint32_t row_base, std::vector<uint32_t>* selection) {
+        Header header;
+        std::memcpy(&header, in, sizeof(header));
+        const uint8_t* packed = in + sizeof(Header);
+        int64_t delta = static_cast<int64_t>(constant) - header.base;
+        int64_t max_delta = header.bit_width == 0 ? 0 : (int64_t(1) << header.bit_width) - 1;
+
+        // Constant outside the frame: every row or no row matches
+        if (delta < 0 || delta > max_delta) {
+            bool all = (delta < 0) ? (op == CompareOp::GT || op == CompareOp::GE || op == CompareOp::NE)
+                                   : (op == CompareOp::LT || op == CompareOp::LE || op == CompareOp::NE);
+            if (all) {
+                for (uint32_t i = 0; i < header.count; ++i) selection->push_back(row_base + i);
+            }
+            return;
+        }
+        uint32_t d = static_cast<uint32_t>(delta);
+        for (uint32_t i = 0; i < header.count; ++i) {
+            if (Compare(BitPacker::Get(packed, i, header.bit_width), op, d)) {
+                selection->push_back(row_base + i);
+            }
+        }
+    }
+
+private:
+    static Header MakeHeader(const int32_t* values, size_t count) {
+        Header header{0, static_cast<uint32_t>(count), 0};
+        if (count == 0) return header;
+        auto minmax = std::minmax_element(values, values + count);
+        header.base = *minmax.first;
+        header.bit_width = BitPacker::BitsRequired(
+            static_cast<uint64_t>(static_cast<int64_t>(*minmax.second) - *minmax.first));
+        return header;
+    }
+
+    template <typename T>
+    static bool Compare(T lhs, CompareOp op, T rhs) {
+        switch (op) {
+            case CompareOp::EQ: return lhs == rhs;
+            case CompareOp::NE: return lhs != rhs;
+            case CompareOp::LT: return lhs < rhs;
+            case CompareOp::LE: return lhs <= rhs;
+            case CompareOp::GT: return lhs > rhs;
+            case CompareOp::GE: return lhs >= rhs;
+        }
+        return false;
+    }
+};
+
+// Run-length encoding over int32: a predicate is evaluated once per run.
+// int32 only: ChooseEncoding() considers RLE for INTEGER and BOOLEAN
+// minipages (BOOLEAN widened to int32); VARCHAR runs are covered by
+// DICTIONARY, whose codes are fixed width.
+class RunLengthEncoding {
+public:
+    struct Run {
+        int32_t value;
+        uint32_t length;
+    };
+
+    static std::vector<Run> Encode(const int32_t* values, size_t count) {
+        std::vector<Run> runs;
+        for (size_t i = 0; i < count; ++i) {
+            if (!runs.empty() && runs.back().value == values[i]) {
+                ++runs.back().length;
+            } else {
+                runs.push_back({values[i], 1});
+            }
+        }
+        return runs;
+    }
+
+    static size_t CountRuns(const int32_t* values, size_t count) {
+        size_t runs = count == 0 ? 0 : 1;
+        for (size_t i = 1; i < count; ++i) runs += values[i] != values[i - 1];
+        return runs;
+    }
+
+    static void Select(const Run* runs, size_t num_runs, CompareOp op, int32_t constant,
+                       uint32_t row_base, std::vector<uint32_t>* selection);
+};
+
+// Dictionary encoding for VARCHAR: the dictionary is sorted, so range
+// predicates become code ranges and are evaluated on the packed codes
+class DictionaryEncoding {
+public:
+    static std::vector<std::string> BuildDictionary(const std::vector<std::string>& values);
+
+    // Code range [*lo, *hi) of dictionary entries satisfying `entry op constant`;
+    // NE is returned as the complement of the EQ range via *negate
+    static void TranslatePredicate(const std::vector<std::string>& dictionary,
+                                   CompareOp op, const std::string& constant,
+                                   uint32_t* lo, uint32_t* hi, bool* negate);
+};
+
+// Per-minipage statistics used to pick an encoding when a page is sealed
+struct ColumnStats {
+    size_t count;
+    size_t distinct;     // exact up to the page size
+    size_t runs;
+    int64_t min_value;
+    int64_t max_value;
+    size_t plain_bytes;
+};
+
+// Chooses the smallest encoding for the page; PLAIN if nothing saves
+// at least 1/8 of the plain size. Never returns RLE or FOR_BITPACK when
+// is_varchar is set.
+EncodingType ChooseEncoding(const ColumnStats& stats, bool is_varchar);
+
+} // namespace mokshith
\ No newline at end of file
@@ -1,14 +1,18 @@
 #pragma once
 #include "common/types.h"
-#include <string>
+#include "storage/io_backend.h"
 #include <fstream>
+#include <string>
+#include <memory>
 #include <mutex>
+#include <atomic>
 
 namespace mokshith {
 
 class DiskManager {
 public:
-    explicit DiskManager(const std::string& db_file);
+    explicit DiskManager(const std::string& db_file,
+                         IOBackendType backend_type = IOBackendType::FSTREAM);
     ~DiskManager();
     
     // Page operations
@@ -17,20 +21,45 @@ public:
     page_id_t AllocatePage();
     void DeallocatePage(page_id_t page_id);
     
+    // Async page operations, queued until SubmitIO()
+    bool ReadPageAsync(page_id_t page_id, char* page_data, IOCallback callback);
+    bool WritePageAsync(page_id_t page_id, const char* page_data, IOCallback callback);
+    bool WritePagesAsync(page_id_t first_page_id, const char* data,
+                         size_t num_pages, IOCallback callback);
+    size_t SubmitIO();
+    size_t WaitForIO(size_t min_completions = 1);
+    void DrainIO();
+    
+    // Write-ahead log file, separate from the data file. WriteLog
+    // appends; FlushLog is the fsync group commit waits on.
+    void WriteLog(const char* log_data, size_t size);
+    void FlushLog();
+    // Returns false at end of log
+    bool ReadLog(char* log_data, size_t size, size_t offset, size_t* bytes_read);
+    
     // Database info
     size_t GetFileSize() const;
-    int GetNumWrites() const { return num_writes_; }
-    int GetNumFlushes() const { return num_flushes_; }
+    uint64_t GetNumReads() const { return num_reads_.load(); }
+    uint64_t GetNumWrites() const { return num_writes_.load(); }
+    uint64_t GetNumFlushes() const { return num_flushes_.load(); }
+    IOStats GetIOStats() const { return io_backend_->GetStats(); }
+    IOBackendType GetIOBackendType() const { return io_backend_->GetType(); }
     
     void Flush();
     
 private:
     std::string db_file_name_;
-    std::fstream db_file_;
-    page_id_t next_page_id_;
-    int num_writes_;
-    int num_flushes_;
-    std::mutex db_io_mutex_;
+    std::string log_file_name_;   // db_file_name_ with a .log extension
+    std::unique_ptr<IOBackend> io_backend_;
+    std::atomic<page_id_t> next_page_id_;
+    std::atomic<uint64_t> num_reads_;
+    std::atomic<uint64_t> num_writes_;
+    std::atomic<uint64_t> num_flushes_;
+    std::mutex db_io_mutex_;  // only serializes Flush() and file growth
+    std::fstream log_file_;   // opened on first use
+    std::mutex log_io_mutex_;
+    
+    bool OpenLogFile();
 };
 
 } // namespace mokshith
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+#include "storage/buffer_pool.h"
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace mokshith {
+
+// Persistent free-space map for a TableHeap.
+//
+// Each heap page is summarized by one byte, its reclaimable free space
+// in FSM_BUCKET_BYTES units. The entries, heap page id and category
+// byte, are stored in a chain of FSM pages, so the map survives
+// restart. On open the map is loaded into per-category sets, which lets
+// FindPage() answer in O(FSM_NUM_CATEGORIES) without walking the heap.
+//
+// FSM page: | FSMPageHeader | heap page ids[ENTRIES_PER_FSM_PAGE] |
+//           categories[ENTRIES_PER_FSM_PAGE] |
+class FreeSpaceMap {
+public:
+    static constexpr size_t FSM_BUCKET_BYTES = 32;
+    static constexpr size_t FSM_NUM_CATEGORIES = PAGE_SIZE / FSM_BUCKET_BYTES;
+
+    // first_fsm_page_id == INVALID_PAGE_ID creates an empty map
+    FreeSpaceMap(BufferPool* buffer_pool, page_id_t first_fsm_page_id);
+
+    page_id_t GetFirstPageId() const { return first_fsm_page_id_; }
+
+    // A heap page with at least `required` bytes reclaimable, or
+    // INVALID_PAGE_ID if the heap has to grow
+    page_id_t FindPage(size_t required);
+
+    // Called after every insert/delete/update/compaction that changes a
+    // page's reclaimable space; only dirties the FSM page when the
+    // category changes
+    void Update(page_id_t heap_page_id, size_t free_bytes);
+    void AddPage(page_id_t heap_page_id, size_t free_bytes);
+
+private:
+    struct FSMPageHeader {
+        page_id_t page_id;   // PageHeader prefix
+        lsn_t lsn;
+        page_id_t next_fsm_page_id;
+        uint32_t first_heap_index;
+        uint32_t count;
+    };
+    // Slot i of an FSM page is heap entry first_heap_index + i
+    static constexpr size_t ENTRIES_PER_FSM_PAGE =
+        (PAGE_SIZE - sizeof(FSMPageHeader)) / (sizeof(page_id_t) + sizeof(uint8_t));
+
+    // Entry position -> heap page, heap page -> entry position
+    struct Entry {
+        page_id_t heap_page_id;
+        uint8_t category;
+    };
+
+    static uint8_t ToCategory(size_t free_bytes) {
+        size_t category = free_bytes / FSM_BUCKET_BYTES;
+        return static_cast<uint8_t>(category < FSM_NUM_CATEGORIES ? category : FSM_NUM_CATEGORIES - 1);
+    }
+
+    BufferPool* buffer_pool_;
+    page_id_t first_fsm_page_id_;
+    std::vector<page_id_t> fsm_page_ids_;
+    std::vector<Entry> entries_;
+    std::unordered_map<page_id_t, uint32_t> entry_index_;
+    std::vector<std::unordered_set<page_id_t>> pages_by_category_;
+    std::mutex latch_;
+
+    // Rebuilds entries_, entry_index_ and the category sets from the FSM
+    // pages alone
+    void Load();
+    // Writes entry_index's page id and category to its FSM page slot
+    void Persist(uint32_t entry_index);
+};
+
+} // namespace mokshith
\ No newline at end of file
@@ -0,0 +1,173 @@
+#pragma once
+#include "common/types.h"
+#include "common/config.h"
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+#ifdef MOKSHITH_HAVE_IO_URING
+#include <liburing.h>
+#endif
+
+namespace mokshith {
+
+enum class IOBackendType {
+    FSTREAM,
+    IO_URING
+};
+
+enum class IOOpType : uint8_t {
+    READ,
+    WRITE
+};
+
+// Called once per request with the first page id and 0 or -errno
+using IOCallback = std::function<void(page_id_t, int)>;
+
+// One positional read/write of `num_pages` contiguous pages. Buffers
+// must be PAGE_SIZE-aligned: the io_uring backend uses O_DIRECT.
+struct IORequest {
+    IOOpType op;
+    page_id_t page_id;
+    union {
+        char* read_buffer;          // READ destination
+        const char* write_buffer;   // WRITE source
+    };
+    size_t num_pages;
+    IOCallback callback;
+};
+
+// Heap buffer of whole pages aligned for O_DIRECT
+struct AlignedFree {
+    void operator()(char* buffer) const { std::free(buffer); }
+};
+using AlignedPageBuffer = std::unique_ptr<char[], AlignedFree>;
+
+inline AlignedPageBuffer AllocateAlignedPages(size_t num_pages) {
+    char* buffer = static_cast<char*>(std::aligned_alloc(PAGE_SIZE, num_pages * PAGE_SIZE));
+    if (buffer == nullptr) throw std::bad_alloc();
+    return AlignedPageBuffer(buffer);
+}
+
+// Snapshot of the backend counters
+struct IOStats {
+    uint64_t num_reads;
+    uint64_t num_writes;
+    uint64_t num_syncs;
+    uint64_t num_submits;       // Submit() calls that pushed at least one request
+    uint64_t num_submitted;     // requests pushed to the device
+    uint64_t num_completions;
+    uint64_t bytes_read;
+    uint64_t bytes_written;
+    uint64_t max_in_flight;
+};
+
+class IOBackend {
+public:
+    virtual ~IOBackend() = default;
+
+    virtual bool Open(const std::string& file_name) = 0;
+    virtual void Close() = 0;
+
+    // Synchronous pread/pwrite at page_id * PAGE_SIZE, returns 0 or -errno
+    virtual int Read(page_id_t page_id, char* buffer, size_t num_pages) = 0;
+    virtual int Write(page_id_t page_id, const char* buffer, size_t num_pages) = 0;
+    virtual int Sync() = 0;
+
+    // Asynchronous I/O: Prepare() queues, Submit() pushes the whole batch,
+    // Reap() runs callbacks for at least min_completions finished requests
+    virtual bool Prepare(IORequest request) = 0;
+    virtual size_t Submit() = 0;
+    virtual size_t Reap(size_t min_completions) = 0;
+
+    size_t InFlight() const { return in_flight_.load(); }
+    IOBackendType GetType() const { return type_; }
+    IOStats GetStats() const;
+
+protected:
+    explicit IOBackend(IOBackendType type) : type_(type), in_flight_(0) {}
+
+    IOBackendType type_;
+    std::atomic<size_t> in_flight_;
+
+    std::atomic<uint64_t> num_reads_{0};
+    std::atomic<uint64_t> num_writes_{0};
+    std::atomic<uint64_t> num_syncs_{0};
+    std::atomic<uint64_t> num_submits_{0};
+    std::atomic<uint64_t> num_submitted_{0};
+    std::atomic<uint64_t> num_completions_{0};
+    std::atomic<uint64_t> bytes_read_{0};
+    std::atomic<uint64_t> bytes_written_{0};
+    std::atomic<uint64_t> max_in_flight_{0};
+
+    void RecordSubmit(size_t count);
+    void RecordCompletion(const IORequest& request);
+};
+
+// Fallback backend: one std::fstream behind a mutex, async requests
+// are executed in Submit() and completed in Reap()
+class FStreamIOBackend : public IOBackend {
+public:
+    FStreamIOBackend() : IOBackend(IOBackendType::FSTREAM) {}
+    ~FStreamIOBackend() override;
+
+    bool Open(const std::string& file_name) override;
+    void Close() override;
+
+    int Read(page_id_t page_id, char* buffer, size_t num_pages) override;
+    int Write(page_id_t page_id, const char* buffer, size_t num_pages) override;
+    int Sync() override;
+
+    bool Prepare(IORequest request) override;
+    size_t Submit() override;
+    size_t Reap(size_t min_completions) override;
+
+private:
+    std::fstream file_;
+    std::mutex io_mutex_;
+
+    std::mutex queue_latch_;
+    std::vector<IORequest> pending_;
+    std::vector<std::pair<IORequest, int>> completed_;
+};
+
+#ifdef MOKSHITH_HAVE_IO_URING
+// io_uring backend: pread/pwrite on an O_DIRECT fd, requests are batched
+// into the submission queue and completions are reaped without a global lock
+class IOUringIOBackend : public IOBackend {
+public:
+    explicit IOUringIOBackend(unsigned queue_depth = IO_URING_QUEUE_DEPTH);
+    ~IOUringIOBackend() override;
+
+    bool Open(const std::string& file_name) override;
+    void Close() override;
+
+    int Read(page_id_t page_id, char* buffer, size_t num_pages) override;
+    int Write(page_id_t page_id, const char* buffer, size_t num_pages) override;
+    int Sync() override;
+
+    bool Prepare(IORequest request) override;
+    size_t Submit() override;
+    size_t Reap(size_t min_completions) override;
+
+private:
+    struct io_uring ring_;
+    int fd_;
+    unsigned queue_depth_;
+    size_t prepared_;
+
+    std::mutex sq_latch_;  // submission queue
+    std::mutex cq_latch_;  // completion queue
+};
+#endif
+
+// Returns an io_uring backend when requested and available, otherwise fstream
+std::unique_ptr<IOBackend> CreateIOBackend(IOBackendType type);
+
+} // namespace mokshith
\ No newline at end of file
@@ -1,17 +1,73 @@
 #pragma once
 #include "common/types.h"
+#include "common/optimistic_latch.h"
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
 
 namespace mokshith {
+    // Prefix of every page's data, whatever its layout. Keeping the page
+    // LSN in the page bytes persists it with the page, so WAL gating and
+    // the redo page-LSN check see the same value after eviction or a
+    // restart. Layouts start with these fields or reserve PAGE_HEADER_SIZE.
+    struct PageHeader {
+        page_id_t page_id;
+        lsn_t lsn;
+    };
+    static constexpr size_t PAGE_HEADER_SIZE = sizeof(PageHeader);
+    
     class Page {
     public:
-        Page();
-        ~Page() = default;
+        Page() : Page(nullptr) {}
+        // Uses `data` (PAGE_SIZE bytes, PAGE_SIZE-aligned) as the page's
+        // bytes; the buffer pool passes a slot of its page arena. With
+        // nullptr the page allocates its own.
+        explicit Page(char* data) : data_(data) {
+            if (data_ == nullptr) {
+                data_ = static_cast<char*>(std::aligned_alloc(PAGE_SIZE, PAGE_SIZE));
+                if (data_ == nullptr) throw std::bad_alloc();
+                owned_data_.reset(data_);
+            }
+            Init(INVALID_PAGE_ID);
+        }
+        Page(const Page&) = delete;
+        Page& operator=(const Page&) = delete;
         
-        void Init(page_id_t page_id);
+        // Called whenever the frame is (re)assigned to a page. Resets the
+        // latch too: a node merged away leaves it obsolete, and the next
+        // page in this frame must not inherit that.
+        void Init(page_id_t page_id) {
+            page_id_ = page_id;
+            std::memset(data_, 0, PAGE_SIZE);
+            reinterpret_cast<PageHeader*>(data_)->page_id = page_id;
+            SetLSN(INVALID_LSN);
+            latch_.Reset();
+        }
         page_id_t GetPageId() const { return page_id_; }
+        char* GetData() { return data_; }
+        const char* GetData() const { return data_; }
+        
+        // LSN of the last log record that modified this page; the page may
+        // only be written once the log is durable up to this LSN
+        lsn_t GetLSN() const { return reinterpret_cast<const PageHeader*>(data_)->lsn; }
+        void SetLSN(lsn_t lsn) { reinterpret_cast<PageHeader*>(data_)->lsn = lsn; }
+        
+        // Latch of the frame, used by index nodes for optimistic lock
+        // coupling; only valid while the page is pinned
+        OptimisticLatch& GetLatch() { return latch_; }
         
     private:
-        char data_[PAGE_SIZE];
+        struct DataFree {
+            void operator()(char* data) const { std::free(data); }
+        };
+        
+        // PAGE_SIZE-aligned for O_DIRECT I/O straight into the page.
+        // Held by pointer so the metadata of a frame stays small.
+        char* data_;
+        std::unique_ptr<char, DataFree> owned_data_;
         page_id_t page_id_;
+        OptimisticLatch latch_;
     };
 }
@@ -0,0 +1,64 @@
+#pragma once
+#include "storage/buffer_pool.h"
+
+namespace mokshith {
+
+// RAII pin on a buffer pool page. Move-only; the page is unpinned (with
+// the accumulated dirty flag) when the guard is destroyed, reassigned or
+// Release()d.
+class PageGuard {
+public:
+    PageGuard() : buffer_pool_(nullptr), page_(nullptr), is_dirty_(false) {}
+    PageGuard(BufferPool* buffer_pool, Page* page)
+        : buffer_pool_(buffer_pool), page_(page), is_dirty_(false) {}
+
+    PageGuard(const PageGuard&) = delete;
+    PageGuard& operator=(const PageGuard&) = delete;
+
+    PageGuard(PageGuard&& other) noexcept
+        : buffer_pool_(other.buffer_pool_), page_(other.page_), is_dirty_(other.is_dirty_) {
+        other.page_ = nullptr;
+    }
+
+    PageGuard& operator=(PageGuard&& other) noexcept {
+        if (this != &other) {
+            Release();
+            buffer_pool_ = other.buffer_pool_;
+            page_ = other.page_;
+            is_dirty_ = other.is_dirty_;
+            other.page_ = nullptr;
+        }
+        return *this;
+    }
+
+    ~PageGuard() { Release(); }
+
+    static PageGuard Fetch(BufferPool* buffer_pool, page_id_t page_id,
+                           AccessType access_type = AccessType::RANDOM) {
+        return PageGuard(buffer_pool, buffer_pool->FetchPage(page_id, access_type));
+    }
+
+    void Release() {
+        if (page_ != nullptr) {
+            buffer_pool_->UnpinPage(page_->GetPageId(), is_dirty_);
+            page_ = nullptr;
+        }
+        is_dirty_ = false;
+    }
+
+    bool IsValid() const { return page_ != nullptr; }
+    page_id_t GetPageId() const { return page_ ? page_->GetPageId() : INVALID_PAGE_ID; }
+    Page* GetPage() const { return page_; }
+    const char* GetData() const { return page_->GetData(); }
+    char* GetDataMut() {
+        is_dirty_ = true;
+        return page_->GetData();
+    }
+
+private:
+    BufferPool* buffer_pool_;
+    Page* page_;
+    bool is_dirty_;
+};
+
+} // namespace mokshith
\ No newline at end of file
@@ -0,0 +1,112 @@
+#pragma once
+#include "common/types.h"
+#include <atomic>
+#include <memory>
+
+namespace mokshith {
+
+// page_id -> frame_id map that readers search without any latch.
+//
+// Open addressing with linear probing over a power-of-two array of
+// 64-bit atomic slots, each packing (page_id, frame_id), so a slot is
+// read and written in one atomic operation and a reader never sees half
+// an entry. Writers (Insert/Erase) must be serialized by the caller, the
+// owning shard latch in BufferPool. A Find racing with a writer may
+// miss an entry that is being inserted or return one that is being
+// erased; the buffer pool validates the frame after pinning it and
+// falls back to the latched path.
+//
+// Erase leaves a tombstone so probe chains of other keys stay intact;
+// tombstones are turned back into empty slots when the slot after them
+// is empty, which keeps unsuccessful probes short.
+class ConcurrentPageTable {
+public:
+    static constexpr frame_id_t NOT_FOUND = -1;
+
+    // Sized for at most `max_entries` live entries at <= 50% load
+    explicit ConcurrentPageTable(size_t max_entries) {
+        capacity_ = 16;
+        while (capacity_ < max_entries * 2) capacity_ <<= 1;
+        mask_ = capacity_ - 1;
+        slots_.reset(new std::atomic<uint64_t>[capacity_]);
+        for (size_t i = 0; i < capacity_; ++i) slots_[i].store(EMPTY, std::memory_order_relaxed);
+    }
+
+    frame_id_t Find(page_id_t page_id) const {
+        for (size_t pos = Home(page_id), probes = 0; probes < capacity_; pos = (pos + 1) & mask_, ++probes) {
+            uint64_t slot = slots_[pos].load(std::memory_order_acquire);
+            if (slot == EMPTY) return NOT_FOUND;
+            if (slot != TOMBSTONE && PageOf(slot) == page_id) return FrameOf(slot);
+        }
+        return NOT_FOUND;
+    }
+
+    // Writer only. Returns false if page_id is already present.
+    bool Insert(page_id_t page_id, frame_id_t frame_id) {
+        size_t target = capacity_;
+        for (size_t pos = Home(page_id), probes = 0; probes < capacity_; pos = (pos + 1) & mask_, ++probes) {
+            uint64_t slot = slots_[pos].load(std::memory_order_relaxed);
+            if (slot == EMPTY) {
+                if (target == capacity_) target = pos;
+                break;
+            }
+            if (slot == TOMBSTONE) {
+                if (target == capacity_) target = pos;
+            } else if (PageOf(slot) == page_id) {
+                return false;
+            }
+        }
+        if (target == capacity_) return false;
+        slots_[target].store(Pack(page_id, frame_id), std::memory_order_release);
+        return true;
+    }
+
+    // Writer only
+    bool Erase(page_id_t page_id) {
+        for (size_t pos = Home(page_id), probes = 0; probes < capacity_; pos = (pos + 1) & mask_, ++probes) {
+            uint64_t slot = slots_[pos].load(std::memory_order_relaxed);
+            if (slot == EMPTY) return false;
+            if (slot != TOMBSTONE && PageOf(slot) == page_id) {
+                slots_[pos].store(TOMBSTONE, std::memory_order_release);
+                ReclaimTombstones(pos);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t Capacity() const { return capacity_; }
+
+private:
+    static constexpr uint64_t EMPTY = ~uint64_t(0);
+    static constexpr uint64_t TOMBSTONE = ~uint64_t(0) - 1;
+
+    std::unique_ptr<std::atomic<uint64_t>[]> slots_;
+    size_t capacity_;
+    size_t mask_;
+
+    size_t Home(page_id_t page_id) const {
+        // Fibonacci hashing; sequential page ids land far apart
+        uint64_t h = static_cast<uint32_t>(page_id) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(h >> 32) & mask_;
+    }
+
+    static uint64_t Pack(page_id_t page_id, frame_id_t frame_id) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(page_id)) << 32) |
+               static_cast<uint32_t>(frame_id);
+    }
+    static page_id_t PageOf(uint64_t slot) { return static_cast<page_id_t>(slot >> 32); }
+    static frame_id_t FrameOf(uint64_t slot) { return static_cast<frame_id_t>(slot & 0xFFFFFFFFu); }
+
+    // A tombstone followed by an empty slot ends no other key's probe
+    // chain, so it can become empty itself; walk backwards while so
+    void ReclaimTombstones(size_t pos) {
+        if (slots_[(pos + 1) & mask_].load(std::memory_order_relaxed) != EMPTY) return;
+        for (size_t probes = 0; probes < capacity_; pos = (pos - 1) & mask_, ++probes) {
+            if (slots_[pos].load(std::memory_order_relaxed) != TOMBSTONE) return;
+            slots_[pos].store(EMPTY, std::memory_order_release);
+        }
+    }
+};
+
+} // namespace mokshith
\ No newline at end of file
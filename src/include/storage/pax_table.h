@@ -0,0 +1,187 @@
+#pragma once
+#include "storage/compression.h"
+#include "storage/page_guard.h"
+#include "storage/tuple.h"
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace mokshith {
+
+// PAX page layout: rows are assigned to a page as usual, but inside the
+// page every column has its own minipage, so a scan that projects k
+// columns only touches those k minipages.
+//
+// | Header | ColumnDesc[num_columns] | null bitmaps | minipage 0 | minipage 1 | ...
+//
+// Fixed-width columns store `capacity` values back to back. VARCHAR
+// minipages store a uint16 end-offset array of `capacity` entries
+// followed by the concatenated string bytes. A plain page's capacity and
+// minipage sizes are fixed when it is initialized, from the schema's
+// column widths (VARCHAR uses its declared length / 2 as the size
+// estimate).
+//
+// Sealed pages are built by SealFrom(), not by encoding a plain page in
+// place: minipages are laid out back to back at their encoded lengths
+// and capacity is whatever row count fits after encoding, so a group of
+// plain pages collapses into fewer sealed ones.
+class PaxPage {
+public:
+    struct Header {
+        page_id_t page_id;
+        lsn_t lsn;
+        page_id_t next_page_id;
+        uint16_t num_columns;
+        uint16_t capacity;     // max rows in this page
+        uint16_t num_rows;     // rows appended, including deleted ones
+        uint16_t num_deleted;
+        uint8_t sealed;
+        uint64_t first_row;    // heap row number of row 0, see PaxTableHeap
+    };
+
+    static_assert(offsetof(Header, page_id) == offsetof(PageHeader, page_id) &&
+                  offsetof(Header, lsn) == offsetof(PageHeader, lsn),
+                  "PaxPage header must start with PageHeader");
+
+    struct ColumnDesc {
+        uint16_t offset;       // start of the column's minipage
+        uint16_t size;         // bytes reserved for the minipage
+        uint16_t width;        // value width, 0 for variable length
+        uint16_t used;         // VARCHAR: string bytes used
+        uint16_t null_bitmap;  // offset of the column's null bitmap
+        EncodingType encoding; // PLAIN until the page is sealed
+    };
+
+    explicit PaxPage(Page* page) : data_(page->GetData()) {}
+
+    void Init(page_id_t page_id, const Schema* schema, uint64_t first_row);
+
+    uint16_t GetNumRows() const { return GetHeader()->num_rows; }
+    uint64_t GetFirstRow() const { return GetHeader()->first_row; }
+    page_id_t GetNextPageId() const { return GetHeader()->next_page_id; }
+    void SetNextPageId(page_id_t page_id) { GetHeader()->next_page_id = page_id; }
+
+    // Appends a row, scattering its values into the minipages; returns
+    // false if the page is full or a VARCHAR minipage has no room left
+    bool AppendRow(const std::vector<Value>& values, const Schema* schema, uint16_t* row);
+    bool MarkDelete(uint16_t row);
+    bool IsDeleted(uint16_t row) const;
+    
+    // Initializes this page as a sealed page holding the rows of `sources`
+    // (full plain pages, in row order) starting at row `source_row` of
+    // sources[0]. Each column is encoded with the encoding ChooseEncoding()
+    // picks, and the row count is grown while the encoded minipages,
+    // descriptors and bitmaps still fit in PAGE_SIZE. Deleted rows are
+    // carried over as deleted so row numbers stay dense. Returns the
+    // number of rows taken; the caller seals the remainder into the next
+    // page. Sealed pages take no more appends; deletes only set the
+    // delete bitmap.
+    uint32_t SealFrom(page_id_t page_id, const Schema* schema,
+                      const std::vector<const PaxPage*>& sources, uint16_t source_row);
+    bool IsSealed() const { return GetHeader()->sealed != 0; }
+    
+    // Evaluates `column op constant` on the (possibly encoded) minipage
+    // and appends matching, non-deleted row numbers to *selection
+    void Select(const Schema* schema, uint32_t column_idx, CompareOp op,
+                const Value& constant, std::vector<uint32_t>* selection) const;
+
+    // Column access, touches only the column's minipage
+    const char* GetColumnData(uint32_t column_idx) const {
+        return data_ + GetColumnDesc(column_idx)->offset;
+    }
+    bool IsNull(uint32_t column_idx, uint16_t row) const;
+    Value GetValue(const Schema* schema, uint32_t column_idx, uint16_t row) const;
+
+private:
+    char* data_;
+
+    Header* GetHeader() { return reinterpret_cast<Header*>(data_); }
+    const Header* GetHeader() const { return reinterpret_cast<const Header*>(data_); }
+    const ColumnDesc* GetColumnDesc(uint32_t column_idx) const {
+        return reinterpret_cast<const ColumnDesc*>(data_ + sizeof(Header)) + column_idx;
+    }
+    ColumnDesc* GetColumnDesc(uint32_t column_idx) {
+        return reinterpret_cast<ColumnDesc*>(data_ + sizeof(Header)) + column_idx;
+    }
+};
+
+// Table storage for StorageLayout::PAX tables. Row-level operations
+// reassemble a Tuple from the minipages; scans go through ColumnIterator
+// and read only the projected columns.
+//
+// Rows are appended to plain pages. Once SEAL_GROUP_PAGES plain pages are
+// full they are sealed together into as many sealed pages as the encoded
+// data needs, and the plain pages are deleted. Because sealing moves rows
+// between pages, RIDs are logical: every row gets a heap row number at
+// insert, carried in the RID as (row >> 16, row & 0xFFFF), and pages
+// record the row number of their first row. row_directory_ maps row
+// numbers to pages and is rebuilt from the page headers when the heap
+// is opened.
+class PaxTableHeap {
+public:
+    static constexpr size_t SEAL_GROUP_PAGES = 4;
+
+    static RID RowToRID(uint64_t row) {
+        return RID(static_cast<page_id_t>(row >> 16), static_cast<uint32_t>(row & 0xFFFF));
+    }
+    static uint64_t RIDToRow(const RID& rid) {
+        return (static_cast<uint64_t>(rid.GetPageId()) << 16) | rid.GetSlotNum();
+    }
+
+    PaxTableHeap(BufferPool* buffer_pool, const Schema* schema,
+                 page_id_t first_page_id = INVALID_PAGE_ID);
+
+    bool InsertTuple(const Tuple& tuple, RID* rid, txn_id_t txn_id);
+    bool DeleteTuple(const RID& rid, txn_id_t txn_id);
+    bool GetTuple(const RID& rid, Tuple& tuple, txn_id_t txn_id);
+
+    page_id_t GetFirstPageId() const { return first_page_id_; }
+
+    // Projection-aware scan. Produces the projected values of one row at
+    // a time; values are decoded from minipages of the pinned page only
+    // for column_ids.
+    class ColumnIterator {
+    public:
+        ColumnIterator(PaxTableHeap* heap, std::vector<uint32_t> column_ids);
+
+        bool Next(std::vector<Value>* values, RID* rid);
+
+        // Direct minipage access for batch consumers: the current page
+        // and the column bytes stay valid until the page changes
+        const PaxPage* GetCurrentPage() const { return current_page_ ? &*current_page_ : nullptr; }
+
+    private:
+        PaxTableHeap* heap_;
+        std::vector<uint32_t> column_ids_;
+        PageGuard guard_;
+        std::unique_ptr<PaxPage> current_page_;
+        page_id_t page_id_;
+        uint16_t row_;
+
+        bool AdvancePage();
+    };
+
+    ColumnIterator Scan(const std::vector<uint32_t>& column_ids) {
+        return ColumnIterator(this, column_ids);
+    }
+
+private:
+    BufferPool* buffer_pool_;
+    const Schema* schema_;
+    page_id_t first_page_id_;
+    page_id_t last_page_id_;
+    uint64_t next_row_;
+    // (first_row, page_id) of every page in chain order; first_row is
+    // increasing, so lookups binary-search it
+    std::vector<std::pair<uint64_t, page_id_t>> row_directory_;
+    std::vector<page_id_t> unsealed_pages_;  // full plain pages awaiting a seal
+    std::mutex append_latch_;  // guards the page chain, directory and next_row_
+
+    page_id_t FindPage(uint64_t row) const;
+    // Seals unsealed_pages_ into new pages spliced into the chain in their
+    // place, then deletes the plain pages. Called with append_latch_ held.
+    void SealGroup();
+};
+
+} // namespace mokshith
\ No newline at end of file
@@ -0,0 +1,154 @@
+#pragma once
+#include "common/types.h"
+#include <atomic>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace mokshith {
+
+enum class ReplacerType {
+    LRU,
+    LRU_K,
+    TWO_Q,
+    CLOCK
+};
+
+// Access hint passed down from FetchPage
+enum class AccessType {
+    RANDOM,
+    SEQUENTIAL  // scans: served from the pool's ring buffer
+};
+
+// Frame replacement policy. Pin/Unpin/Victim are called with the owning
+// shard latch held; RecordAccess may be called on the hit path.
+class Replacer {
+public:
+    virtual ~Replacer() = default;
+
+    virtual ReplacerType GetType() const = 0;
+
+    virtual void RecordAccess(frame_id_t frame_id, AccessType access_type) = 0;
+    // Miss path: page_id was just loaded into frame_id. Policies that
+    // remember evicted pages (2Q's A1out) key that history by page id.
+    virtual void RecordPageLoad(frame_id_t /*frame_id*/, page_id_t /*page_id*/) {}
+    virtual bool Victim(frame_id_t* frame_id) = 0;
+    virtual void Pin(frame_id_t frame_id) = 0;
+    virtual void Unpin(frame_id_t frame_id) = 0;
+    virtual void Remove(frame_id_t frame_id) = 0;  // page deleted
+    virtual size_t Size() = 0;
+};
+
+// Plain LRU
+class LRUReplacer : public Replacer {
+public:
+    explicit LRUReplacer(size_t num_frames);
+
+    ReplacerType GetType() const override { return ReplacerType::LRU; }
+    void RecordAccess(frame_id_t frame_id, AccessType access_type) override;
+    bool Victim(frame_id_t* frame_id) override;
+    void Pin(frame_id_t frame_id) override;
+    void Unpin(frame_id_t frame_id) override;
+    void Remove(frame_id_t frame_id) override;
+    size_t Size() override { return lru_map_.size(); }
+
+private:
+    std::list<frame_id_t> lru_list_;
+    std::unordered_map<frame_id_t, std::list<frame_id_t>::iterator> lru_map_;
+};
+
+// LRU-K: evicts the frame with the largest backward K-distance; frames
+// with fewer than K accesses (+inf distance) go first, oldest access wins
+class LRUKReplacer : public Replacer {
+public:
+    LRUKReplacer(size_t num_frames, size_t k = 2);
+
+    ReplacerType GetType() const override { return ReplacerType::LRU_K; }
+    void RecordAccess(frame_id_t frame_id, AccessType access_type) override;
+    bool Victim(frame_id_t* frame_id) override;
+    void Pin(frame_id_t frame_id) override;
+    void Unpin(frame_id_t frame_id) override;
+    void Remove(frame_id_t frame_id) override;
+    size_t Size() override { return evictable_count_; }
+
+private:
+    struct FrameHistory {
+        std::list<uint64_t> timestamps;  // most recent K, newest at front
+        bool evictable = false;
+    };
+
+    size_t k_;
+    uint64_t current_timestamp_;
+    size_t evictable_count_;
+    std::vector<FrameHistory> history_;
+};
+
+// 2Q: first touch goes to a FIFO probation queue (A1in) whose evicted
+// ids are remembered in A1out; only re-referenced pages enter the main
+// LRU (Am), so a one-pass scan never displaces the hot set
+class TwoQReplacer : public Replacer {
+public:
+    TwoQReplacer(size_t num_frames, double a1in_ratio = 0.25, double a1out_ratio = 0.5);
+
+    ReplacerType GetType() const override { return ReplacerType::TWO_Q; }
+    void RecordAccess(frame_id_t frame_id, AccessType access_type) override;
+    bool Victim(frame_id_t* frame_id) override;
+    void Pin(frame_id_t frame_id) override;
+    void Unpin(frame_id_t frame_id) override;
+    void Remove(frame_id_t frame_id) override;
+    size_t Size() override { return evictable_count_; }
+
+    // A page found in A1out was evicted from A1in recently and goes
+    // straight to Am
+    void RecordPageLoad(frame_id_t frame_id, page_id_t page_id) override;
+
+private:
+    enum class Queue : uint8_t { NONE, A1IN, AM };
+
+    struct FrameState {
+        Queue queue = Queue::NONE;
+        page_id_t page_id = INVALID_PAGE_ID;
+        bool evictable = false;
+        std::list<frame_id_t>::iterator pos;
+    };
+
+    size_t a1in_max_;
+    size_t a1out_max_;
+    size_t evictable_count_;
+    std::vector<FrameState> frames_;
+    std::list<frame_id_t> a1in_;
+    std::list<frame_id_t> am_;
+    std::list<page_id_t> a1out_;
+    std::unordered_map<page_id_t, std::list<page_id_t>::iterator> a1out_map_;
+};
+
+// CLOCK (second chance). Reference and pin bits are atomics, so
+// RecordAccess/Pin/Unpin never take a lock; only Victim sweeps the hand.
+class ClockReplacer : public Replacer {
+public:
+    explicit ClockReplacer(size_t num_frames);
+
+    ReplacerType GetType() const override { return ReplacerType::CLOCK; }
+    void RecordAccess(frame_id_t frame_id, AccessType access_type) override;
+    bool Victim(frame_id_t* frame_id) override;
+    void Pin(frame_id_t frame_id) override;
+    void Unpin(frame_id_t frame_id) override;
+    void Remove(frame_id_t frame_id) override;
+    size_t Size() override { return evictable_count_.load(); }
+
+private:
+    struct ClockEntry {
+        std::atomic<bool> referenced{false};
+        std::atomic<bool> evictable{false};
+    };
+
+    size_t num_frames_;
+    std::unique_ptr<ClockEntry[]> entries_;
+    std::atomic<size_t> hand_;
+    std::atomic<size_t> evictable_count_;
+};
+
+std::unique_ptr<Replacer> CreateReplacer(ReplacerType type, size_t num_frames);
+
+} // namespace mokshith
\ No newline at end of file
@@ -0,0 +1,111 @@
+#pragma once
+#include "storage/page.h"
+#include "storage/tuple.h"
+
+namespace mokshith {
+
+// Slotted page layout:
+// | Header | Slot[0] Slot[1] ... -->        free        <-- ... Tuple1 Tuple0 |
+//
+// Header:   page_id | lsn | prev_page_id | next_page_id |
+//           free_space_pointer | slot_count | live_count
+// Slot:     offset (uint16) | size (uint16) | flags (uint16)
+// Tuple:    version timestamp (timestamp_t, see transaction/mvcc.h) |
+//           tuple bytes; size covers both
+//
+// Slots are never moved, so a RID (page_id, slot) stays valid for the
+// lifetime of the tuple. A tuple that no longer fits in its page after
+// an update is moved and its home slot becomes a FORWARD stub holding
+// the new RID; the moved copy is flagged MOVED_IN so scans skip it.
+class TablePage {
+public:
+    static constexpr uint16_t SLOT_FREE = 0x0;
+    static constexpr uint16_t SLOT_LIVE = 0x1;
+    static constexpr uint16_t SLOT_FORWARD = 0x2;   // data is a RID
+    static constexpr uint16_t SLOT_MOVED_IN = 0x4;  // reached via a FORWARD slot
+
+    struct Header {
+        page_id_t page_id;
+        lsn_t lsn;
+        page_id_t prev_page_id;
+        page_id_t next_page_id;
+        uint16_t free_space_pointer;  // start of tuple data
+        uint16_t slot_count;
+        uint16_t live_count;
+        uint16_t fragmented_bytes;    // reclaimable by Compact()
+    };
+
+    struct Slot {
+        uint16_t offset;
+        uint16_t size;
+        uint16_t flags;
+    };
+
+    static constexpr size_t HEADER_SIZE = sizeof(Header);
+    // Header::lsn is the page LSN Page::GetLSN/SetLSN read and write
+    static_assert(offsetof(Header, page_id) == offsetof(PageHeader, page_id) &&
+                  offsetof(Header, lsn) == offsetof(PageHeader, lsn),
+                  "TablePage header must start with PageHeader");
+    static constexpr size_t SLOT_SIZE = sizeof(Slot);
+
+    // Overlays the layout on a pinned page's data
+    explicit TablePage(Page* page) : data_(page->GetData()) {}
+
+    void Init(page_id_t page_id, page_id_t prev_page_id);
+
+    page_id_t GetPageId() const { return GetHeader()->page_id; }
+    page_id_t GetPrevPageId() const { return GetHeader()->prev_page_id; }
+    page_id_t GetNextPageId() const { return GetHeader()->next_page_id; }
+    void SetNextPageId(page_id_t page_id) { GetHeader()->next_page_id = page_id; }
+    uint16_t GetSlotCount() const { return GetHeader()->slot_count; }
+
+    // Contiguous free bytes between the slot directory and tuple data
+    size_t GetFreeSpace() const {
+        return GetHeader()->free_space_pointer - HEADER_SIZE - GetSlotCount() * SLOT_SIZE;
+    }
+    // Free bytes after Compact(), the value reported to the free-space map
+    size_t GetReclaimableSpace() const { return GetFreeSpace() + GetHeader()->fragmented_bytes; }
+
+    // Reuses a SLOT_FREE entry before growing the directory; compacts the
+    // page first if the tuple only fits after compaction
+    bool InsertTuple(const Tuple& tuple, uint16_t flags, uint16_t* slot_num);
+    bool MarkDelete(uint16_t slot_num);
+    void ApplyDelete(uint16_t slot_num);
+    void RollbackDelete(uint16_t slot_num);
+
+    // Updates in place when the new tuple fits (after compaction if
+    // needed); otherwise returns false and the heap forwards the tuple
+    bool UpdateTuple(const Tuple& new_tuple, uint16_t slot_num, Tuple* old_tuple);
+    void SetForward(uint16_t slot_num, const RID& new_rid);
+
+    // MVCC version timestamp of a LIVE tuple: commit timestamp or the
+    // writer's TXN_TIMESTAMP_FLAG marker. Under MVCC MarkDelete only
+    // stamps the tuple; ApplyDelete runs once GC finds the delete
+    // visible to every snapshot.
+    timestamp_t GetTupleTimestamp(uint16_t slot_num) const;
+    void SetTupleTimestamp(uint16_t slot_num, timestamp_t ts);
+
+    // Returns false for free slots; for FORWARD slots fills *forward_rid
+    bool GetTuple(uint16_t slot_num, Tuple* tuple, RID* forward_rid) const;
+    bool IsVisibleInScan(uint16_t slot_num) const {
+        return GetSlot(slot_num)->flags == SLOT_LIVE;
+    }
+
+    // Slides live tuples to the end of the page, closing holes left by
+    // deletes and shrinking updates; slot numbers are unchanged
+    void Compact();
+
+private:
+    char* data_;  // the Page's data, TablePage is overlaid on a pinned Page
+
+    Header* GetHeader() { return reinterpret_cast<Header*>(data_); }
+    const Header* GetHeader() const { return reinterpret_cast<const Header*>(data_); }
+    Slot* GetSlot(uint16_t slot_num) {
+        return reinterpret_cast<Slot*>(data_ + HEADER_SIZE) + slot_num;
+    }
+    const Slot* GetSlot(uint16_t slot_num) const {
+        return reinterpret_cast<const Slot*>(data_ + HEADER_SIZE) + slot_num;
+    }
+};
+
+} // namespace mokshith
\ No newline at end of file
@@ -1,16 +1,26 @@
 #pragma once
 #include "common/types.h"
+#include "common/rid.h"
 #include "catalog/schema.h"
+#include "storage/free_space_map.h"
+#include "storage/page_guard.h"
+#include "transaction/mvcc.h"
+#include <memory>
 #include <vector>
 
 namespace mokshith {
 
+class TupleView;
+class Transaction;
+
 // Tuple format:
 // | Header | Null Bitmap | Column Data... |
 class Tuple {
 public:
     Tuple() = default;
     Tuple(std::vector<Value> values, const Schema* schema);
+    // Materializes a view: the only place a scanned row is copied
+    explicit Tuple(const TupleView& view);
     
     // Serialize/Deserialize
     void SerializeTo(char* storage) const;
@@ -22,28 +32,86 @@ public:
     size_t GetSize() const { return size_; }
     const char* GetData() const { return data_; }
     
+    // Decodes one column straight from serialized tuple bytes; shared by
+    // Tuple and TupleView so both read the same format
+    static Value GetValue(const char* data, const Schema* schema, uint32_t column_idx);
+    static bool IsNull(const char* data, uint32_t column_idx);
+    
 private:
     size_t size_;
     char* data_;
     bool allocated_;
 };
 
+// Non-owning view of a serialized tuple inside a pinned page. The view
+// is valid as long as the PageGuard it came from holds the pin; for
+// TableHeap::Iterator that is until the iterator leaves the page.
+// Copy to a Tuple only when an operator has to keep the row.
+class TupleView {
+public:
+    TupleView() : data_(nullptr), size_(0) {}
+    TupleView(const char* data, size_t size, RID rid)
+        : data_(data), size_(size), rid_(rid) {}
+    explicit TupleView(const Tuple& tuple)
+        : data_(tuple.GetData()), size_(tuple.GetSize()) {}
+    
+    Value GetValue(const Schema* schema, uint32_t column_idx) const {
+        return Tuple::GetValue(data_, schema, column_idx);
+    }
+    bool IsNull(uint32_t column_idx) const { return Tuple::IsNull(data_, column_idx); }
+    
+    size_t GetSize() const { return size_; }
+    const char* GetData() const { return data_; }
+    const RID& GetRID() const { return rid_; }
+    bool IsValid() const { return data_ != nullptr; }
+    
+    Tuple Materialize() const { return Tuple(*this); }
+    
+private:
+    const char* data_;
+    size_t size_;
+    RID rid_;
+};
+
 class TableHeap {
 public:
-    TableHeap(BufferPool* buffer_pool, const Schema* schema);
+    // Heap pages are slotted TablePages chained through next_page_id;
+    // first_page_id == INVALID_PAGE_ID creates a new heap
+    TableHeap(BufferPool* buffer_pool, const Schema* schema,
+              page_id_t first_page_id = INVALID_PAGE_ID,
+              page_id_t first_fsm_page_id = INVALID_PAGE_ID);
     ~TableHeap();
     
     // Tuple operations
-    bool InsertTuple(const Tuple& tuple, txn_id_t txn_id);
+    // InsertTuple asks the free-space map for a page with room before
+    // appending a new page; UpdateTuple forwards tuples that outgrow their
+    // page and GetTuple follows the forward RID
+    bool InsertTuple(const Tuple& tuple, RID* rid, txn_id_t txn_id);
     bool DeleteTuple(const RID& rid, txn_id_t txn_id);
     bool UpdateTuple(const Tuple& tuple, const RID& rid, txn_id_t txn_id);
     bool GetTuple(const RID& rid, Tuple& tuple, txn_id_t txn_id);
+    // Zero-copy lookup: *guard receives the pin backing *view
+    bool GetTupleView(const RID& rid, TupleView* view, PageGuard* guard, txn_id_t txn_id);
+    
+    // Snapshot read: the heap version if visible at txn's read
+    // timestamp, else the version reconstructed from the undo chain;
+    // false if the tuple did not exist for the snapshot. Takes no locks.
+    bool GetVisibleTuple(const RID& rid, Transaction* txn,
+                         VersionStore<RID>* versions, Tuple* tuple);
     
-    // Iterator for sequential scan
+    page_id_t GetFirstPageId() const { return first_page_id_; }
+    // Walks the page chain headers; used to split parallel scans into morsels
+    std::vector<page_id_t> CollectPageIds();
+    page_id_t GetFreeSpaceMapPageId() const { return fsm_->GetFirstPageId(); }
+    
+    // Iterator for sequential scan. Keeps the current page pinned in a
+    // PageGuard and hands out views into it, so stepping allocates and
+    // copies nothing; the pin moves when the iterator changes page.
     class Iterator {
     public:
         Iterator(TableHeap* table_heap, RID rid);
-        const Tuple& operator*();
+        const TupleView& operator*() const { return current_view_; }
+        const TupleView* operator->() const { return &current_view_; }
         Iterator& operator++();
         bool operator==(const Iterator& other) const;
         bool operator!=(const Iterator& other) const;
@@ -51,7 +119,18 @@ public:
     private:
         TableHeap* table_heap_;
         RID current_rid_;
-        Tuple current_tuple_;
+        PageGuard current_page_;
+        TupleView current_view_;
+        
+        // Read-ahead: once two consecutive page moves are +1 apart the
+        // window starts at 2 pages and doubles up to READ_AHEAD_PAGES;
+        // a non-sequential move resets it
+        page_id_t prev_page_id_;
+        size_t sequential_moves_;
+        size_t read_ahead_window_;
+        page_id_t read_ahead_until_;  // first page not yet prefetched
+        
+        void OnPageChange(page_id_t new_page_id);
     };
     
     Iterator Begin(txn_id_t txn_id);
@@ -62,6 +141,10 @@ private:
     const Schema* schema_;
     page_id_t first_page_id_;
     page_id_t last_page_id_;
+    std::unique_ptr<FreeSpaceMap> fsm_;
+    
+    page_id_t AppendPage();
+    bool InsertIntoPage(page_id_t page_id, const Tuple& tuple, uint16_t flags, RID* rid);
 };
 
 } // namespace mokshith
\ No newline at end of file
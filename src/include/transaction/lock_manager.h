@@ -1,52 +1,120 @@
 #pragma once
 #include "transaction/transaction.h"
+#include "transaction/lock_mode.h"
+#include "common/config.h"
+#include <chrono>
 #include <condition_variable>
 #include <list>
 #include <unordered_map>
 
 namespace mokshith {
 
-enum class LockMode {
-    SHARED,
-    EXCLUSIVE
-};
-
+// Hierarchical two-phase locking over tables, pages and rows.
+//
+// The lock table is split into LOCK_TABLE_PARTITIONS hash partitions,
+// each with its own latch and map of request queues, so unrelated lock
+// requests do not serialize on a single latch.
+//
+// LockRow takes IS/IX on the table (and page, if page locks are in use)
+// before the row lock. Once a transaction holds more than the escalation
+// threshold of row locks on one table, it is escalated: the table lock
+// becomes S (only shared rows) or X, and its row locks on that table are
+// released. Later LockRow calls covered by the table lock return without
+// touching the lock table. A scan over a million rows thus costs a few
+// thousand queue entries at most, not a million.
 class LockManager {
 public:
-    LockManager();
+    static constexpr size_t LOCK_TABLE_PARTITIONS = 64;
+    static constexpr std::chrono::milliseconds DEADLOCK_DETECTION_INTERVAL{50};
+
+    explicit LockManager(size_t escalation_threshold = LOCK_ESCALATION_THRESHOLD);
     ~LockManager();
-    
-    bool LockShared(Transaction* txn, const RID& rid);
-    bool LockExclusive(Transaction* txn, const RID& rid);
-    bool LockUpgrade(Transaction* txn, const RID& rid);
-    bool Unlock(Transaction* txn, const RID& rid);
-    
+
+    bool LockTable(Transaction* txn, uint32_t table_oid, LockMode lock_mode);
+    bool LockPage(Transaction* txn, uint32_t table_oid, page_id_t page_id, LockMode lock_mode);
+    // SHARED or EXCLUSIVE; acquires the intention locks above it
+    bool LockRow(Transaction* txn, uint32_t table_oid, const RID& rid, LockMode lock_mode);
+
+    bool LockShared(Transaction* txn, uint32_t table_oid, const RID& rid) {
+        return LockRow(txn, table_oid, rid, LockMode::SHARED);
+    }
+    bool LockExclusive(Transaction* txn, uint32_t table_oid, const RID& rid) {
+        return LockRow(txn, table_oid, rid, LockMode::EXCLUSIVE);
+    }
+    bool LockUpgrade(Transaction* txn, uint32_t table_oid, const RID& rid) {
+        return LockRow(txn, table_oid, rid, LockMode::EXCLUSIVE);
+    }
+
+    bool Unlock(Transaction* txn, const LockResource& resource);
+    // Commit / abort: releases everything the transaction holds
+    void UnlockAll(Transaction* txn);
+
+    size_t GetEscalationThreshold() const { return escalation_threshold_; }
+    void SetEscalationThreshold(size_t threshold) { escalation_threshold_ = threshold; }
+
+    struct Stats {
+        uint64_t acquired;
+        uint64_t waits;
+        uint64_t escalations;
+        uint64_t covered;   // row requests satisfied by a table lock
+    };
+    Stats GetStats() const;
+
 private:
     struct LockRequest {
+        Transaction* txn;   // aborted through this by deadlock detection
         txn_id_t txn_id;
         LockMode lock_mode;
         bool granted;
     };
-    
+
     struct LockRequestQueue {
         std::list<LockRequest> request_queue;
         std::condition_variable cv;
-        bool upgrading = false;
+        // Holder waiting to strengthen its granted request, -1 if none.
+        // Only one upgrade may wait per queue.
+        txn_id_t upgrading = -1;
+    };
+
+    struct Partition {
+        std::mutex latch;
+        std::unordered_map<LockResource, std::unique_ptr<LockRequestQueue>,
+                           LockResourceHash> lock_table;
     };
-    
-    std::unordered_map<RID, std::unique_ptr<LockRequestQueue>> lock_table_;
-    std::mutex lock_table_latch_;
-    
-    bool GrantLock(Transaction* txn, const RID& rid, LockMode lock_mode);
-    void WaitForLock(Transaction* txn, const RID& rid, LockMode lock_mode);
-    void ReleaseLock(Transaction* txn, const RID& rid);
-    
-    // Deadlock detection
+
+    Partition partitions_[LOCK_TABLE_PARTITIONS];
+    std::atomic<size_t> escalation_threshold_;
+
+    std::atomic<uint64_t> acquired_;
+    std::atomic<uint64_t> waits_;
+    std::atomic<uint64_t> escalations_;
+    std::atomic<uint64_t> covered_;
+
+    Partition& GetPartition(const LockResource& resource) {
+        return partitions_[LockResourceHash()(resource) % LOCK_TABLE_PARTITIONS];
+    }
+
+    // Grants `lock_mode` on one resource, upgrading an existing request
+    // with CombineLocks; waits while incompatible requests are ahead
+    bool Acquire(Transaction* txn, const LockResource& resource, LockMode lock_mode);
+    void Release(Transaction* txn, const LockResource& resource);
+    bool GrantLock(LockRequestQueue* queue, txn_id_t txn_id, LockMode lock_mode);
+
+    // Table lock S or X replacing the transaction's row locks on table_oid
+    bool Escalate(Transaction* txn, uint32_t table_oid);
+
+    // Deadlock detection: builds the waits-for graph one partition at a
+    // time, so detection never holds more than one partition latch. The
+    // youngest transaction on a cycle is aborted and its waits wake up.
     std::thread* deadlock_detection_thread_;
     std::atomic<bool> enable_deadlock_detection_;
+    std::mutex detection_latch_;
+    std::condition_variable detection_cv_;  // shutdown
     void RunDeadlockDetection();
-    bool HasCycle(txn_id_t txn_id, 
-                  std::unordered_map<txn_id_t, std::vector<txn_id_t>>& wait_graph);
+    // Sets *victim to the largest txn id on the cycle
+    bool HasCycle(txn_id_t txn_id,
+                  const std::unordered_map<txn_id_t, std::vector<txn_id_t>>& wait_graph,
+                  txn_id_t* victim);
 };
 
 } // namespace mokshith
\ No newline at end of file
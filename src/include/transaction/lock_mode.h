@@ -0,0 +1,105 @@
+#pragma once
+#include "common/types.h"
+#include <functional>
+
+namespace mokshith {
+
+// Multi-granularity lock modes. Intention modes on a table or page
+// announce row (or page) locks below it, so a table-level S or X can be
+// checked against one queue instead of every row.
+enum class LockMode : uint8_t {
+    INTENTION_SHARED,
+    INTENTION_EXCLUSIVE,
+    SHARED,
+    SHARED_INTENTION_EXCLUSIVE,
+    EXCLUSIVE
+};
+
+enum class LockGranularity : uint8_t {
+    TABLE,
+    PAGE,
+    ROW
+};
+
+//          IS   IX   S    SIX  X
+//   IS     y    y    y    y    n
+//   IX     y    y    n    n    n
+//   S      y    n    y    n    n
+//   SIX    y    n    n    n    n
+//   X      n    n    n    n    n
+inline bool AreLocksCompatible(LockMode held, LockMode requested) {
+    static constexpr bool matrix[5][5] = {
+        {true,  true,  true,  true,  false},
+        {true,  true,  false, false, false},
+        {true,  false, true,  false, false},
+        {true,  false, false, false, false},
+        {false, false, false, false, false},
+    };
+    return matrix[static_cast<int>(held)][static_cast<int>(requested)];
+}
+
+// True if `held` already grants everything `requested` does
+inline bool LockCovers(LockMode held, LockMode requested) {
+    switch (held) {
+        case LockMode::EXCLUSIVE: return true;
+        case LockMode::SHARED_INTENTION_EXCLUSIVE: return requested != LockMode::EXCLUSIVE;
+        case LockMode::SHARED:
+            return requested == LockMode::SHARED || requested == LockMode::INTENTION_SHARED;
+        case LockMode::INTENTION_EXCLUSIVE:
+            return requested == LockMode::INTENTION_EXCLUSIVE ||
+                   requested == LockMode::INTENTION_SHARED;
+        case LockMode::INTENTION_SHARED: return requested == LockMode::INTENTION_SHARED;
+    }
+    return false;
+}
+
+// Weakest mode that covers both, used when a holder asks for more
+// (S + IX = SIX)
+inline LockMode CombineLocks(LockMode a, LockMode b) {
+    if (LockCovers(a, b)) return a;
+    if (LockCovers(b, a)) return b;
+    if (a == LockMode::EXCLUSIVE || b == LockMode::EXCLUSIVE) return LockMode::EXCLUSIVE;
+    // Remaining pairs are {S, IX} and {S or IX, SIX}
+    return LockMode::SHARED_INTENTION_EXCLUSIVE;
+}
+
+// Intention mode to hold on the parent before locking a child in `mode`
+inline LockMode IntentionFor(LockMode mode) {
+    return mode == LockMode::SHARED || mode == LockMode::INTENTION_SHARED
+               ? LockMode::INTENTION_SHARED
+               : LockMode::INTENTION_EXCLUSIVE;
+}
+
+// A lockable object: a table, a page of a table, or a row (page, slot)
+struct LockResource {
+    LockGranularity granularity;
+    uint32_t table_oid;
+    page_id_t page_id;   // PAGE and ROW
+    uint32_t slot;       // ROW
+
+    static LockResource Table(uint32_t table_oid) {
+        return LockResource{LockGranularity::TABLE, table_oid, INVALID_PAGE_ID, 0};
+    }
+    static LockResource Page(uint32_t table_oid, page_id_t page_id) {
+        return LockResource{LockGranularity::PAGE, table_oid, page_id, 0};
+    }
+    static LockResource Row(uint32_t table_oid, page_id_t page_id, uint32_t slot) {
+        return LockResource{LockGranularity::ROW, table_oid, page_id, slot};
+    }
+
+    bool operator==(const LockResource& other) const {
+        return granularity == other.granularity && table_oid == other.table_oid &&
+               page_id == other.page_id && slot == other.slot;
+    }
+};
+
+struct LockResourceHash {
+    size_t operator()(const LockResource& resource) const {
+        uint64_t h = static_cast<uint64_t>(resource.table_oid) * 0x9E3779B97F4A7C15ull;
+        h ^= (static_cast<uint64_t>(static_cast<uint32_t>(resource.page_id)) << 20) ^ resource.slot;
+        h ^= static_cast<uint64_t>(resource.granularity) << 62;
+        return static_cast<size_t>(h * 0xBF58476D1CE4E5B9ull ^ (h >> 31));
+    }
+};
+
+} // namespace mokshith
\ No newline at end of file
@@ -1,7 +1,12 @@
 #pragma once
 #include "storage/disk_manager.h"
+#include "common/rid.h"
+#include "common/config.h"
+#include "common/latency_histogram.h"
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstring>
 #include <future>
 #include <queue>
 
@@ -14,7 +19,9 @@ enum class LogRecordType {
     INSERT,
     DELETE,
     UPDATE,
-    CHECKPOINT
+    CHECKPOINT,
+    INDEX_BUILD,
+    PAGE_WRITE
 };
 
 struct LogRecord {
@@ -41,44 +48,141 @@ struct LogRecord {
             size_t new_size;
             char update_data[0];  // old data followed by new data
         };
+        struct {  // INDEX_BUILD: pages were forced before this record
+            oid_t index_oid;
+            page_id_t index_root_page_id;
+        };
+        struct {  // PAGE_WRITE: physical bytes at an offset of page_id
+            uint32_t write_offset;
+            uint32_t write_size;
+            char write_data[0];  // before image followed by after image
+        };
     };
     
+    // Redo and undo of a PAGE_WRITE copy an image back into the page
+    // bytes; neither depends on the page layout
+    void RedoPageWrite(char* page_data) const {
+        std::memcpy(page_data + write_offset, write_data + write_size, write_size);
+    }
+    void UndoPageWrite(char* page_data) const {
+        std::memcpy(page_data + write_offset, write_data, write_size);
+    }
+    
+    // A record occupies sizeof(LogRecord) plus its variable-length data;
+    // the serialized form is those bytes
     size_t GetSize() const;
     void SerializeTo(char* buffer) const;
+    // `this` must have room for the record's GetSize() bytes
     void DeserializeFrom(const char* buffer);
 };
 
+struct GroupCommitStats {
+    uint64_t groups;          // fsyncs issued by the flush thread
+    uint64_t commits;         // Flush(lsn) waiters released
+    uint64_t max_group_size;
+    uint64_t buffer_full_waits;  // appends that waited for a buffer swap
+    uint64_t latency_p50_us;  // Flush(lsn) call to durable
+    uint64_t latency_p95_us;
+    uint64_t latency_p99_us;
+    uint64_t latency_max_us;
+    
+    double AverageGroupSize() const {
+        return groups == 0 ? 0.0 : static_cast<double>(commits) / groups;
+    }
+};
+
+// Write-ahead log with a latch-free append path and group commit.
+//
+// Two log buffers alternate: appenders fill the active one while the
+// flush thread writes the other. Space and LSN are reserved together by
+// one fetch_add on reservation_, which packs
+//   | buffer index (1) | records in buffer (31) | byte offset (32) |
+// so the LSN is the buffer's base LSN plus the record count, and LSN
+// order equals log order. The record is then copied outside any latch
+// and published by adding its size to the buffer's copied_bytes.
+//
+// An append that would overflow the active buffer seals it and waits
+// for SwapLogBuffer, which switches reservation_ to the other buffer
+// once the flush thread has written it out.
+//
+// Group commit: Flush(lsn) registers the waiter and blocks. The flush
+// thread wakes on the first waiter, lingers up to group_commit_window
+// for more commits (or until the buffer is half full), seals the buffer,
+// waits for in-flight copies to finish, then writes and fsyncs once for
+// the whole group.
 class LogManager {
 public:
-    LogManager(DiskManager* disk_manager);
+    explicit LogManager(DiskManager* disk_manager,
+                        size_t log_buffer_size = LOG_BUFFER_SIZE,
+                        std::chrono::microseconds group_commit_window =
+                            std::chrono::microseconds(GROUP_COMMIT_WINDOW_US));
     ~LogManager();
     
     lsn_t AppendLogRecord(const LogRecord& log_record);
     
+    // Blocks until the log is durable up to lsn
     void Flush(lsn_t lsn);
     void FlushAll();
     
+    lsn_t GetPersistentLSN() const { return persistent_lsn_.load(); }
+    
+    DiskManager* GetDiskManager() const { return disk_manager_; }
+    
+    GroupCommitStats GetGroupCommitStats() const;
+    void ResetGroupCommitStats();
+    
     // Recovery
     void Redo();
     void Undo();
     
 private:
+    struct LogBuffer {
+        char* data;
+        // LSN of the first record: the sealed buffer's base_lsn plus its
+        // record count, set by SwapLogBuffer. With reservation_ this is
+        // the only source of LSNs.
+        lsn_t base_lsn;
+        std::atomic<size_t> copied_bytes;    // bytes fully copied in
+    };
+    
+    static constexpr uint64_t OFFSET_MASK = 0xFFFFFFFFull;
+    static constexpr uint64_t RECORD_ONE = uint64_t(1) << 32;
+    static constexpr uint64_t BUFFER_BIT = uint64_t(1) << 63;
+    
     DiskManager* disk_manager_;
     
-    char* log_buffer_;
+    LogBuffer buffers_[2];
     size_t log_buffer_size_;
-    std::atomic<size_t> log_buffer_offset_;
+    std::atomic<uint64_t> reservation_;
+    // Offset at which the active buffer was sealed, 0 while open
+    std::atomic<size_t> sealed_offset_;
     
-    std::atomic<lsn_t> next_lsn_;
     std::atomic<lsn_t> persistent_lsn_;
     
+    std::chrono::microseconds group_commit_window_;
+    // Flush waiters and the flush thread meet here; appends never take it
     std::mutex latch_;
-    std::condition_variable cv_flush_;
+    std::condition_variable cv_flush_;    // wakes the flush thread
+    std::condition_variable cv_durable_;  // wakes commit waiters
+    std::condition_variable cv_swapped_;  // wakes appenders on a full buffer
+    size_t pending_commits_;
+    lsn_t max_requested_lsn_;
     std::thread* flush_thread_;
     std::atomic<bool> enable_flushing_;
     
+    std::atomic<uint64_t> groups_;
+    std::atomic<uint64_t> commits_;
+    std::atomic<uint64_t> max_group_size_;
+    std::atomic<uint64_t> buffer_full_waits_;
+    LatencyHistogram commit_latency_;
+    
+    // Returns false if the record does not fit; the caller seals the
+    // buffer and retries after the swap
+    bool TryReserve(size_t size, size_t* buffer_index, size_t* offset, lsn_t* lsn);
     void RunFlushThread();
-    void SwapLogBuffer();
+    // Seals the active buffer, waits for its copies, switches appends to
+    // the other buffer; returns the sealed buffer and its size
+    LogBuffer* SwapLogBuffer(size_t* bytes);
 };
 
 } // namespace mokshith
\ No newline at end of file
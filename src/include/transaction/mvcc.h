@@ -0,0 +1,190 @@
+#pragma once
+#include "common/types.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace mokshith {
+
+// Multi-version concurrency control.
+//
+// Every tuple in the heap carries the timestamp of the version stored
+// there (TablePage keeps it in front of the tuple bytes): either the
+// commit timestamp of the transaction that wrote it, or, while that
+// transaction is running, TXN_TIMESTAMP_FLAG | txn_id. Older versions
+// live in an in-memory undo store as a newest-to-oldest chain of full
+// before-images per RID.
+//
+// A reader with read timestamp R sees the heap version if it is its own
+// write or was committed at or before R; otherwise it walks the chain to
+// the first undo record whose timestamp is <= R.
+
+static constexpr timestamp_t TXN_TIMESTAMP_FLAG = timestamp_t(1) << 62;
+
+inline timestamp_t TxnTimestamp(txn_id_t txn_id) {
+    return TXN_TIMESTAMP_FLAG | static_cast<uint32_t>(txn_id);
+}
+inline bool IsUncommitted(timestamp_t ts) { return (ts & TXN_TIMESTAMP_FLAG) != 0; }
+
+inline bool IsVersionVisible(timestamp_t version_ts, timestamp_t read_ts, txn_id_t reader) {
+    if (IsUncommitted(version_ts)) return version_ts == TxnTimestamp(reader);
+    return version_ts <= read_ts;
+}
+
+// Before-image of one tuple version
+struct UndoLog {
+    timestamp_t ts;          // when this version became current
+    bool is_deleted;         // the version is a tombstone (tuple did not exist)
+    std::vector<char> image; // serialized tuple, empty if is_deleted
+    std::shared_ptr<UndoLog> prev;
+};
+
+// Newest undo record visible at read_ts, or null if the tuple did not
+// exist for this snapshot
+inline const UndoLog* FindVisibleVersion(const UndoLog* head, timestamp_t read_ts) {
+    for (const UndoLog* log = head; log != nullptr; log = log->prev.get()) {
+        if (!IsUncommitted(log->ts) && log->ts <= read_ts) return log->is_deleted ? nullptr : log;
+    }
+    return nullptr;
+}
+
+// Drops every record behind the first one at or below the watermark:
+// no running or future snapshot can reach them. Returns records freed.
+inline size_t TruncateVersionChain(std::shared_ptr<UndoLog>* head, timestamp_t heap_ts,
+                                   timestamp_t watermark) {
+    // The heap version itself is visible to everyone: the whole chain goes
+    if (!IsUncommitted(heap_ts) && heap_ts <= watermark) {
+        size_t freed = 0;
+        for (const UndoLog* log = head->get(); log != nullptr; log = log->prev.get()) ++freed;
+        head->reset();
+        return freed;
+    }
+    for (UndoLog* log = head->get(); log != nullptr; log = log->prev.get()) {
+        if (!IsUncommitted(log->ts) && log->ts <= watermark) {
+            size_t freed = 0;
+            for (const UndoLog* old = log->prev.get(); old != nullptr; old = old->prev.get()) ++freed;
+            log->prev.reset();
+            return freed;
+        }
+    }
+    return 0;
+}
+
+// Read timestamps of running snapshots. The watermark, the oldest one,
+// bounds which versions garbage collection must keep.
+class Watermark {
+public:
+    explicit Watermark(timestamp_t commit_ts = 0) : commit_ts_(commit_ts) {}
+
+    void AddReader(timestamp_t read_ts) {
+        std::lock_guard<std::mutex> guard(latch_);
+        ++readers_[read_ts];
+    }
+
+    void RemoveReader(timestamp_t read_ts) {
+        std::lock_guard<std::mutex> guard(latch_);
+        auto it = readers_.find(read_ts);
+        if (it != readers_.end() && --it->second == 0) readers_.erase(it);
+    }
+
+    void UpdateCommitTimestamp(timestamp_t commit_ts) {
+        std::lock_guard<std::mutex> guard(latch_);
+        commit_ts_ = commit_ts;
+    }
+
+    // Oldest active read timestamp, or the latest commit if none
+    timestamp_t Get() const {
+        std::lock_guard<std::mutex> guard(latch_);
+        return readers_.empty() ? commit_ts_ : readers_.begin()->first;
+    }
+
+private:
+    mutable std::mutex latch_;
+    timestamp_t commit_ts_;
+    std::map<timestamp_t, size_t> readers_;
+};
+
+// Undo chains by tuple, partitioned by hash so writers on different
+// tuples rarely share a latch. Key is RID in the engine.
+template <typename Key, typename Hash = std::hash<Key>>
+class VersionStore {
+public:
+    static constexpr size_t NUM_PARTITIONS = 64;
+
+    // Pushes a before-image in front of key's chain
+    void Push(const Key& key, std::shared_ptr<UndoLog> log) {
+        Partition& partition = GetPartition(key);
+        std::lock_guard<std::mutex> guard(partition.latch);
+        std::shared_ptr<UndoLog>& head = partition.chains[key];
+        log->prev = std::move(head);
+        head = std::move(log);
+    }
+
+    std::shared_ptr<UndoLog> GetHead(const Key& key) {
+        Partition& partition = GetPartition(key);
+        std::lock_guard<std::mutex> guard(partition.latch);
+        auto it = partition.chains.find(key);
+        return it == partition.chains.end() ? nullptr : it->second;
+    }
+
+    // Abort: restores the previous head and returns the popped record
+    std::shared_ptr<UndoLog> Pop(const Key& key) {
+        Partition& partition = GetPartition(key);
+        std::lock_guard<std::mutex> guard(partition.latch);
+        auto it = partition.chains.find(key);
+        if (it == partition.chains.end()) return nullptr;
+        std::shared_ptr<UndoLog> head = std::move(it->second);
+        if (head->prev) {
+            it->second = head->prev;
+        } else {
+            partition.chains.erase(it);
+        }
+        return head;
+    }
+
+    // Garbage collection pass. heap_ts(key) returns the timestamp of the
+    // heap version; chains that become empty are removed. Safe with
+    // concurrent readers: a reader's snapshot is at or above the
+    // watermark, so its walk stops at or before the last kept record.
+    template <typename HeapTimestamp>
+    size_t Collect(timestamp_t watermark, HeapTimestamp&& heap_ts) {
+        size_t freed = 0;
+        for (Partition& partition : partitions_) {
+            std::lock_guard<std::mutex> guard(partition.latch);
+            for (auto it = partition.chains.begin(); it != partition.chains.end();) {
+                freed += TruncateVersionChain(&it->second, heap_ts(it->first), watermark);
+                if (it->second == nullptr) {
+                    it = partition.chains.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+        return freed;
+    }
+
+    size_t NumChains() {
+        size_t chains = 0;
+        for (Partition& partition : partitions_) {
+            std::lock_guard<std::mutex> guard(partition.latch);
+            chains += partition.chains.size();
+        }
+        return chains;
+    }
+
+private:
+    struct Partition {
+        std::mutex latch;
+        std::unordered_map<Key, std::shared_ptr<UndoLog>, Hash> chains;
+    };
+
+    Partition partitions_[NUM_PARTITIONS];
+
+    Partition& GetPartition(const Key& key) {
+        return partitions_[Hash()(key) % NUM_PARTITIONS];
+    }
+};
+
+} // namespace mokshith
\ No newline at end of file
@@ -1,20 +1,54 @@
 #pragma once
 #include "transaction/log_manager.h"
 #include "transaction/transaction_manager.h"
+#include "transaction/redo_dispatcher.h"
+#include "common/config.h"
 #include <unordered_map>
 #include <unordered_set>
 
 namespace mokshith {
 
+struct RecoveryStats {
+    uint64_t analysis_us;
+    uint64_t redo_us;
+    uint64_t undo_us;
+    uint64_t log_bytes_scanned;
+    uint64_t records_redone;
+    uint64_t records_skipped;    // page not dirty or record before recLSN, never pinned
+    uint64_t records_applied_before;  // page pinned, page LSN showed it was applied
+    uint64_t pages_prefetched;
+    size_t redo_workers;
+};
+
+// ARIES restart: Analysis, Redo, Undo.
+//
+// Redo is parallel. One thread scans the log from the smallest recLSN
+// in the dirty page table and dispatches each page-level record to one
+// of num_redo_workers threads chosen by page_id, so records for a page
+// are replayed in log order by a single worker and pages replay in
+// parallel with no latching between workers. Before the scan starts,
+// every worker's share of the dirty page table is prefetched in recLSN
+// order, so the first records a worker replays find their pages loaded.
+// Records for pages not in the dirty page table, or older than the
+// page's recLSN, are skipped without pinning the page. Otherwise the
+// worker pins the page and compares the record with the page LSN, which
+// lives in the page bytes (PageHeader, the same field as
+// TablePage::Header::lsn) and so survives the crash. Applying a record
+// stamps its LSN there, which makes slot-level redo (INSERT, DELETE)
+// idempotent across repeated restarts.
 class RecoveryManager {
 public:
     RecoveryManager(LogManager* log_manager,
                    TransactionManager* txn_manager,
-                   BufferPool* buffer_pool);
+                   BufferPool* buffer_pool,
+                   size_t num_redo_workers = RECOVERY_REDO_WORKERS);
     
     void StartRecovery();
     void Checkpoint();
     
+    void SetRedoWorkers(size_t num_redo_workers) { num_redo_workers_ = num_redo_workers; }
+    RecoveryStats GetRecoveryStats() const;
+    
 private:
     // ARIES recovery phases
     void Analysis();
@@ -24,12 +58,34 @@ private:
     LogManager* log_manager_;
     TransactionManager* txn_manager_;
     BufferPool* buffer_pool_;
+    size_t num_redo_workers_;
     
     // Recovery state
     std::unordered_map<txn_id_t, lsn_t> active_txn_table_;
     std::unordered_map<page_id_t, lsn_t> dirty_page_table_;
     lsn_t checkpoint_lsn_;
     
+    // Redo dispatches whole serialized records; a worker deserializes
+    // and applies them to a page only it touches
+    using RedoDispatcherType = RedoDispatcher<std::vector<char>>;
+    // Issues PrefetchPages for each worker's dirty pages, lowest recLSN first
+    size_t PrefetchDirtyPages(size_t num_workers);
+    // Worker side: the recLSN check, then pin, the page LSN check,
+    // RedoOperation and SetLSN(record.lsn)
+    void RedoOnWorker(size_t worker_id, const LogRecord& record);
+    // Reads the record at *offset from the log file and advances
+    // *offset; false at end of log
+    bool ReadLogRecord(size_t* offset, std::vector<char>* record);
+    
+    std::atomic<uint64_t> records_redone_;
+    std::atomic<uint64_t> records_skipped_;
+    std::atomic<uint64_t> records_applied_before_;
+    RecoveryStats stats_;
+    
+    // Must touch no page other than record.page_id: redo workers run
+    // it concurrently for different pages. PAGE_WRITE is physical and
+    // goes through LogRecord::RedoPageWrite / UndoPageWrite; INSERT,
+    // DELETE and UPDATE are replayed through TablePage by rid.
     void RedoOperation(const LogRecord& record);
     void UndoOperation(const LogRecord& record);
 };
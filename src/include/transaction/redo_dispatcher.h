@@ -0,0 +1,109 @@
+#pragma once
+#include "common/types.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mokshith {
+
+// Fans redo work out to worker threads partitioned by page.
+//
+// Every item for a given page goes to the same worker, and each worker
+// applies its items in dispatch order, so per-page log order is kept
+// while different pages replay in parallel. The single log reader calls
+// Dispatch in LSN order; items are handed over in batches to keep
+// latch traffic off the per-record path, and each worker's queue is
+// bounded so the reader cannot run arbitrarily far ahead of redo.
+template <typename Item>
+class RedoDispatcher {
+public:
+    static constexpr size_t BATCH_SIZE = 256;
+    static constexpr size_t MAX_QUEUED_BATCHES = 64;
+
+    // apply(worker_id, item) runs on the worker that owns item's page
+    RedoDispatcher(size_t num_workers, std::function<void(size_t, Item&)> apply)
+        : apply_(std::move(apply)) {
+        if (num_workers == 0) num_workers = 1;
+        workers_.reserve(num_workers);
+        for (size_t i = 0; i < num_workers; ++i) workers_.emplace_back(new Worker());
+        for (size_t i = 0; i < num_workers; ++i) {
+            workers_[i]->thread = std::thread(&RedoDispatcher::RunWorker, this, i);
+        }
+    }
+
+    ~RedoDispatcher() { Finish(); }
+
+    RedoDispatcher(const RedoDispatcher&) = delete;
+    RedoDispatcher& operator=(const RedoDispatcher&) = delete;
+
+    size_t NumWorkers() const { return workers_.size(); }
+
+    static size_t WorkerFor(page_id_t page_id, size_t num_workers) {
+        return static_cast<uint32_t>(page_id) % num_workers;
+    }
+
+    void Dispatch(page_id_t page_id, Item item) {
+        Worker& worker = *workers_[WorkerFor(page_id, workers_.size())];
+        worker.pending.push_back(std::move(item));
+        if (worker.pending.size() >= BATCH_SIZE) Publish(worker);
+    }
+
+    // Hands over partial batches and waits for every worker to drain
+    void Finish() {
+        if (finished_) return;
+        finished_ = true;
+        for (auto& worker : workers_) {
+            Publish(*worker);
+            std::lock_guard<std::mutex> guard(worker->latch);
+            worker->done = true;
+            worker->cv_work.notify_one();
+        }
+        for (auto& worker : workers_) worker->thread.join();
+    }
+
+private:
+    struct Worker {
+        std::mutex latch;
+        std::condition_variable cv_work;
+        std::condition_variable cv_space;
+        std::deque<std::vector<Item>> batches;
+        bool done = false;
+        std::vector<Item> pending;   // reader side only
+        std::thread thread;
+    };
+
+    std::function<void(size_t, Item&)> apply_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    bool finished_ = false;
+
+    void Publish(Worker& worker) {
+        if (worker.pending.empty()) return;
+        std::unique_lock<std::mutex> lock(worker.latch);
+        worker.cv_space.wait(lock, [&]() { return worker.batches.size() < MAX_QUEUED_BATCHES; });
+        worker.batches.push_back(std::move(worker.pending));
+        worker.pending.clear();
+        worker.cv_work.notify_one();
+    }
+
+    void RunWorker(size_t worker_id) {
+        Worker& worker = *workers_[worker_id];
+        while (true) {
+            std::vector<Item> batch;
+            {
+                std::unique_lock<std::mutex> lock(worker.latch);
+                worker.cv_work.wait(lock, [&]() { return worker.done || !worker.batches.empty(); });
+                if (worker.batches.empty()) return;
+                batch = std::move(worker.batches.front());
+                worker.batches.pop_front();
+                worker.cv_space.notify_one();
+            }
+            for (Item& item : batch) apply_(worker_id, item);
+        }
+    }
+};
+
+} // namespace mokshith
\ No newline at end of file
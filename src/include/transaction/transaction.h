@@ -1,12 +1,20 @@
 #pragma once
 #include "common/types.h"
-#include <unordered_set>
+#include "common/rid.h"
+#include "transaction/mvcc.h"
+#include "transaction/lock_mode.h"
 #include <unordered_map>
 #include <memory>
 #include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace mokshith {
 
+class LockManager;
+class LogManager;
+
 enum class TransactionState {
     GROWING,
     SHRINKING,
@@ -14,6 +22,9 @@ enum class TransactionState {
     ABORTED
 };
 
+// READ_COMMITTED and REPEATABLE_READ read MVCC snapshots and take no
+// read locks: READ_COMMITTED takes a fresh snapshot per statement,
+// REPEATABLE_READ one per transaction. SERIALIZABLE keeps strict 2PL.
 enum class IsolationLevel {
     READ_UNCOMMITTED,
     READ_COMMITTED,
@@ -21,6 +32,23 @@ enum class IsolationLevel {
     SERIALIZABLE
 };
 
+enum class WriteType {
+    INSERT,
+    DELETE,
+    UPDATE
+};
+
+// One heap write of the transaction, undone newest first on abort. The
+// before-image is in the version store, so the record only says where.
+struct WriteRecord {
+    WriteRecord(oid_t table_oid, const RID& rid, WriteType type)
+        : table_oid(table_oid), rid(rid), type(type) {}
+
+    oid_t table_oid;
+    RID rid;
+    WriteType type;
+};
+
 class Transaction {
 public:
     explicit Transaction(txn_id_t txn_id, 
@@ -28,6 +56,8 @@ public:
         : txn_id_(txn_id),
           state_(TransactionState::GROWING),
           isolation_level_(isolation_level),
+          read_ts_(0),
+          commit_ts_(0),
           prev_lsn_(INVALID_LSN) {}
     
     txn_id_t GetTransactionId() const { return txn_id_; }
@@ -36,14 +66,26 @@ public:
     
     void SetState(TransactionState state) { state_ = state; }
     
-    // Lock management
-    void AddSharedLock(const RID& rid) { shared_lock_set_.insert(rid); }
-    void AddExclusiveLock(const RID& rid) { exclusive_lock_set_.insert(rid); }
-    void RemoveSharedLock(const RID& rid) { shared_lock_set_.erase(rid); }
-    void RemoveExclusiveLock(const RID& rid) { exclusive_lock_set_.erase(rid); }
+    // MVCC
+    bool UsesSnapshot() const {
+        return isolation_level_ == IsolationLevel::READ_COMMITTED ||
+               isolation_level_ == IsolationLevel::REPEATABLE_READ;
+    }
+    timestamp_t GetReadTimestamp() const { return read_ts_; }
+    void SetReadTimestamp(timestamp_t ts) { read_ts_ = ts; }
+    timestamp_t GetCommitTimestamp() const { return commit_ts_; }
+    void SetCommitTimestamp(timestamp_t ts) { commit_ts_ = ts; }
+    // Marker written into the heap for versions this transaction created
+    timestamp_t GetTxnTimestamp() const { return TxnTimestamp(txn_id_); }
     
-    const std::unordered_set<RID>& GetSharedLockSet() const { return shared_lock_set_; }
-    const std::unordered_set<RID>& GetExclusiveLockSet() const { return exclusive_lock_set_; }
+    // Lock management. Every lock held, at any granularity, with its
+    // mode; the only record of the transaction's locks, maintained by
+    // LockManager and only touched by the transaction's own thread
+    std::unordered_map<LockResource, LockMode, LockResourceHash>& GetHeldLocks() {
+        return held_locks_;
+    }
+    // Row locks held per table, for escalation
+    size_t& RowLockCount(uint32_t table_oid) { return row_lock_counts_[table_oid]; }
     
     // Write set for rollback
     void AddToWriteSet(const WriteRecord& record) { write_set_.push_back(record); }
@@ -57,14 +99,21 @@ private:
     txn_id_t txn_id_;
     std::atomic<TransactionState> state_;
     IsolationLevel isolation_level_;
+    timestamp_t read_ts_;
+    timestamp_t commit_ts_;
     
-    std::unordered_set<RID> shared_lock_set_;
-    std::unordered_set<RID> exclusive_lock_set_;
+    std::unordered_map<LockResource, LockMode, LockResourceHash> held_locks_;
+    std::unordered_map<uint32_t, size_t> row_lock_counts_;
     std::vector<WriteRecord> write_set_;
     
     lsn_t prev_lsn_;
 };
 
+// Timestamps come from one counter: Begin reads the last commit
+// timestamp as the snapshot, Commit takes the next one and stamps the
+// transaction's heap versions with it. Writers still take exclusive row
+// locks; a write to a tuple whose heap version committed after the
+// writer's snapshot aborts (first updater wins).
 class TransactionManager {
 public:
     TransactionManager(LockManager* lock_manager, LogManager* log_manager);
@@ -74,7 +123,30 @@ public:
     void Commit(Transaction* txn);
     void Abort(Transaction* txn);
     
+    // READ_COMMITTED: moves the snapshot to the latest commit
+    void BeginStatement(Transaction* txn);
+    
+    VersionStore<RID>* GetVersionStore() { return &version_store_; }
+    timestamp_t GetWatermark() const { return watermark_.Get(); }
+    
+    // Drops undo records no snapshot can see, and purges heap tuples
+    // whose delete is visible to every snapshot. Runs every
+    // gc_interval_ms on a background thread; exposed for tests.
+    size_t GarbageCollect();
+    
 private:
+    std::atomic<timestamp_t> last_commit_ts_;
+    Watermark watermark_;
+    VersionStore<RID> version_store_;
+    // Commit is serialized so timestamps become visible in order
+    std::mutex commit_latch_;
+    
+    std::thread* gc_thread_;
+    std::atomic<bool> enable_gc_;
+    size_t gc_interval_ms_ = 100;
+    void RunGarbageCollection();
+    
+
     std::atomic<txn_id_t> next_txn_id_;
     std::unordered_map<txn_id_t, std::unique_ptr<Transaction>> txn_map_;
     LockManager* lock_manager_;
@@ -0,0 +1,126 @@
+#include "storage/background_writer.h"
+#include <chrono>
+
+namespace mokshith {
+
+BackgroundWriter::BackgroundWriter(BufferPool* buffer_pool,
+                                   DiskManager* disk_manager,
+                                   LogManager* log_manager,
+                                   const BackgroundWriterConfig& config)
+    : buffer_pool_(buffer_pool),
+      disk_manager_(disk_manager),
+      log_manager_(log_manager),
+      config_(config),
+      writer_thread_(nullptr),
+      running_(false),
+      wakeup_requested_(false),
+      staging_buffer_(AllocateAlignedPages(config.max_pages_per_round)),
+      rounds_(0),
+      pages_written_(0),
+      writes_issued_(0),
+      skipped_wal_(0),
+      skipped_redirtied_(0) {
+    if (config_.max_coalesce_pages == 0) config_.max_coalesce_pages = 1;
+    if (log_manager_ != nullptr) buffer_pool_->SetLogManager(log_manager_);
+    buffer_pool_->SetBackgroundWriter(this);
+}
+
+BackgroundWriter::~BackgroundWriter() {
+    Stop();
+    buffer_pool_->SetBackgroundWriter(nullptr);
+}
+
+void BackgroundWriter::Start() {
+    if (running_.exchange(true)) return;
+    writer_thread_ = new std::thread(&BackgroundWriter::RunWriterThread, this);
+}
+
+void BackgroundWriter::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_.exchange(false)) return;
+    }
+    cv_.notify_all();
+    writer_thread_->join();
+    delete writer_thread_;
+    writer_thread_ = nullptr;
+}
+
+void BackgroundWriter::Wakeup() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wakeup_requested_ = true;
+    }
+    cv_.notify_one();
+}
+
+size_t BackgroundWriter::RunOnce() {
+    std::vector<BufferPool::DirtyFrameSnapshot> snapshots;
+    size_t skipped_wal = 0;
+    size_t collected = buffer_pool_->CollectDirtyFrames(config_.max_pages_per_round, staging_buffer_.get(),
+                                                        &snapshots, &skipped_wal);
+    rounds_.fetch_add(1);
+    skipped_wal_.fetch_add(skipped_wal);
+    if (collected == 0) return 0;
+
+    // Snapshots are in page_id order and packed in the staging buffer,
+    // so a run of adjacent page ids is one contiguous write
+    std::vector<int> results(snapshots.size(), -1);
+    std::atomic<size_t> completed(0);
+    size_t issued = 0;
+    size_t start = 0;
+    while (start < snapshots.size()) {
+        size_t end = start + 1;
+        while (end < snapshots.size() && end - start < config_.max_coalesce_pages &&
+               snapshots[end].page_id == snapshots[end - 1].page_id + 1) {
+            ++end;
+        }
+        auto callback = [&results, &completed, start, end](page_id_t, int result) {
+            for (size_t i = start; i < end; ++i) results[i] = result;
+            completed.fetch_add(1, std::memory_order_release);
+        };
+        if (disk_manager_->WritePagesAsync(snapshots[start].page_id, snapshots[start].data,
+                                           end - start, callback)) {
+            ++issued;
+        }
+        start = end;
+    }
+    disk_manager_->DrainIO();
+    // Completions reaped by another thread still run our callbacks
+    while (completed.load(std::memory_order_acquire) < issued) std::this_thread::yield();
+    writes_issued_.fetch_add(issued);
+
+    size_t written = 0;
+    for (size_t i = 0; i < snapshots.size(); ++i) {
+        if (results[i] != 0) continue;
+        ++written;
+        if (!buffer_pool_->MarkFrameClean(snapshots[i])) skipped_redirtied_.fetch_add(1);
+    }
+    pages_written_.fetch_add(written);
+    return written;
+}
+
+BackgroundWriterStats BackgroundWriter::GetStats() const {
+    BackgroundWriterStats stats;
+    stats.rounds = rounds_.load();
+    stats.pages_written = pages_written_.load();
+    stats.writes_issued = writes_issued_.load();
+    stats.skipped_wal = skipped_wal_.load();
+    stats.skipped_redirtied = skipped_redirtied_.load();
+    return stats;
+}
+
+void BackgroundWriter::RunWriterThread() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait_for(lock, std::chrono::milliseconds(config_.interval_ms),
+                         [this] { return wakeup_requested_ || !running_.load(); });
+            if (!running_.load()) return;
+            wakeup_requested_ = false;
+        }
+        if (buffer_pool_->NumCleanEvictable() < config_.clean_target) RunOnce();
+    }
+}
+
+} // namespace mokshith
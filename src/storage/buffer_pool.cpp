@@ -0,0 +1,560 @@
+#include "storage/buffer_pool.h"
+#include "storage/background_writer.h"
+#include "transaction/log_manager.h"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace mokshith {
+
+BufferPool::Shard::Shard(frame_id_t first_frame, size_t num_frames, ReplacerType replacer_type)
+    : first_frame(first_frame),
+      num_frames(num_frames),
+      // Ring pages are registered in their shard's table as well
+      page_table(num_frames + SCAN_RING_SIZE),
+      replacer(CreateReplacer(replacer_type, num_frames)) {
+    for (size_t i = 0; i < num_frames; ++i) free_list.push_back(first_frame + static_cast<frame_id_t>(i));
+}
+
+BufferPool::BufferPool(size_t pool_size, DiskManager* disk_manager,
+                       size_t num_shards, ReplacerType replacer_type)
+    : pool_size_(pool_size),
+      frames_(AllocateFrames(pool_size, &page_arena_)),
+      disk_manager_(disk_manager),
+      log_manager_(nullptr),
+      bg_writer_(nullptr),
+      replacer_type_(replacer_type),
+      hits_(0),
+      latch_free_hits_(0),
+      misses_(0),
+      evictions_(0),
+      ring_hits_(0),
+      ring_misses_(0),
+      prefetch_issued_(0),
+      prefetch_hits_(0),
+      dirty_evictions_(0) {
+    size_t ring_size = pool_size >= 4 * SCAN_RING_SIZE ? SCAN_RING_SIZE : 0;
+    size_t main_frames = pool_size - ring_size;
+    for (size_t i = 0; i < ring_size; ++i) {
+        scan_ring_.frames.push_back(static_cast<frame_id_t>(main_frames + i));
+    }
+    scan_ring_.next = 0;
+
+    num_shards = std::max<size_t>(1, std::min(num_shards, main_frames / MIN_FRAMES_PER_SHARD));
+    frame_id_t first = 0;
+    for (size_t i = 0; i < num_shards; ++i) {
+        size_t frames = main_frames / num_shards + (i < main_frames % num_shards ? 1 : 0);
+        shards_.push_back(std::make_unique<Shard>(first, frames, replacer_type));
+        first += static_cast<frame_id_t>(frames);
+    }
+}
+
+BufferPool::~BufferPool() {
+    // Outstanding prefetches complete into frames_
+    disk_manager_->DrainIO();
+    FlushAllPages();
+    FreeFrames(frames_, pool_size_);
+}
+
+Page* BufferPool::TryFetchLatchFree(Shard& shard, page_id_t page_id) {
+    frame_id_t frame_id = shard.page_table.Find(page_id);
+    if (frame_id == ConcurrentPageTable::NOT_FOUND) return nullptr;
+    Frame& frame = frames_[frame_id];
+    int pins = frame.pin_count.load();
+    do {
+        if (pins < 0) return nullptr;
+    } while (!frame.pin_count.compare_exchange_weak(pins, pins + 1));
+    // The frame may have been reassigned between Find and the pin
+    if (frame.page_id.load() != page_id || frame.io_in_progress.load()) {
+        frame.pin_count.fetch_sub(1);
+        return nullptr;
+    }
+    frame.referenced.store(true, std::memory_order_relaxed);
+    return &frame.page;
+}
+
+Page* BufferPool::FetchPage(page_id_t page_id, AccessType access_type) {
+    Shard& shard = GetShard(page_id);
+    if (Page* page = TryFetchLatchFree(shard, page_id)) {
+        hits_.fetch_add(1);
+        latch_free_hits_.fetch_add(1);
+        frame_id_t frame_id = shard.page_table.Find(page_id);
+        if (frame_id != ConcurrentPageTable::NOT_FOUND) {
+            if (frames_[frame_id].prefetched.exchange(false)) prefetch_hits_.fetch_add(1);
+            if (access_type == AccessType::SEQUENTIAL && IsRingFrame(frame_id)) ring_hits_.fetch_add(1);
+        }
+        return page;
+    }
+
+    std::unique_lock<std::mutex> lock(shard.latch);
+    frame_id_t ring_frame = -1;
+    bool tried_ring = false;
+    while (true) {
+        frame_id_t frame_id = shard.page_table.Find(page_id);
+        if (frame_id != ConcurrentPageTable::NOT_FOUND) {
+            Frame& frame = frames_[frame_id];
+            if (frame.io_in_progress.load()) {
+                WaitForFrameIO(shard, lock, frame_id);
+                continue;
+            }
+            if (ring_frame != -1) {
+                // Loaded by someone else while we claimed a ring frame
+                frames_[ring_frame].pin_count.store(0);
+            }
+            frame.pin_count.fetch_add(1);
+            hits_.fetch_add(1);
+            if (frame.prefetched.exchange(false)) prefetch_hits_.fetch_add(1);
+            if (IsRingFrame(frame_id)) {
+                if (access_type == AccessType::SEQUENTIAL) ring_hits_.fetch_add(1);
+            } else {
+                shard.replacer->RecordAccess(frame_id - shard.first_frame, access_type);
+            }
+            return &frame.page;
+        }
+
+        // Scans take a ring frame. The ring latch comes before shard
+        // latches, so drop ours and look again afterwards.
+        if (access_type == AccessType::SEQUENTIAL && !scan_ring_.frames.empty() && !tried_ring) {
+            tried_ring = true;
+            lock.unlock();
+            ring_frame = GetRingFrame();
+            lock.lock();
+            if (ring_frame != -1) continue;
+        }
+        break;
+    }
+
+    misses_.fetch_add(1);
+    frame_id_t frame_id = ring_frame;
+    if (frame_id != -1) {
+        ring_misses_.fetch_add(1);
+    } else if (!shard.free_list.empty()) {
+        frame_id = shard.free_list.front();
+        shard.free_list.pop_front();
+    } else {
+        frame_id = GetVictimFrame(shard);
+        if (frame_id == -1) return nullptr;
+    }
+
+    InstallPage(shard, frame_id, page_id);
+    ReadFrame(shard, lock, frame_id);
+    Frame& frame = frames_[frame_id];
+    frame.pin_count.store(1);
+    if (!IsRingFrame(frame_id)) {
+        frame_id_t local = frame_id - shard.first_frame;
+        shard.replacer->RecordPageLoad(local, page_id);
+        shard.replacer->RecordAccess(local, access_type);
+        shard.replacer->Unpin(local);
+    }
+    return &frame.page;
+}
+
+bool BufferPool::UnpinPage(page_id_t page_id, bool is_dirty) {
+    Shard& shard = GetShard(page_id);
+    frame_id_t frame_id = shard.page_table.Find(page_id);
+    if (frame_id == ConcurrentPageTable::NOT_FOUND) return false;
+    Frame& frame = frames_[frame_id];
+    if (frame.page_id.load() != page_id) return false;
+    // Dirty before the pin is dropped, so an evictor that claims the
+    // frame sees it
+    if (is_dirty) {
+        frame.is_dirty.store(true);
+        frame.dirty_version.fetch_add(1);
+    }
+    int pins = frame.pin_count.load();
+    do {
+        if (pins <= 0) return false;
+    } while (!frame.pin_count.compare_exchange_weak(pins, pins - 1));
+    return true;
+}
+
+bool BufferPool::FlushPage(page_id_t page_id) {
+    Shard& shard = GetShard(page_id);
+    std::unique_lock<std::mutex> lock(shard.latch);
+    frame_id_t frame_id;
+    while ((frame_id = shard.page_table.Find(page_id)) != ConcurrentPageTable::NOT_FOUND &&
+           frames_[frame_id].io_in_progress.load()) {
+        WaitForFrameIO(shard, lock, frame_id);
+    }
+    if (frame_id == ConcurrentPageTable::NOT_FOUND) return false;
+    Frame& frame = frames_[frame_id];
+    if (!frame.is_dirty.load()) return true;
+    if (log_manager_ != nullptr && frame.page.GetLSN() > log_manager_->GetPersistentLSN()) return false;
+    frame.is_dirty.store(false);
+    disk_manager_->WritePage(page_id, frame.page.GetData());
+    return true;
+}
+
+Page* BufferPool::NewPage(page_id_t& page_id) {
+    page_id = disk_manager_->AllocatePage();
+    Shard& shard = GetShard(page_id);
+    std::unique_lock<std::mutex> lock(shard.latch);
+    frame_id_t frame_id;
+    if (!shard.free_list.empty()) {
+        frame_id = shard.free_list.front();
+        shard.free_list.pop_front();
+    } else {
+        frame_id = GetVictimFrame(shard);
+        if (frame_id == -1) return nullptr;
+    }
+
+    InstallPage(shard, frame_id, page_id);
+    Frame& frame = frames_[frame_id];
+    // Written on eviction even if the caller never dirties it
+    frame.is_dirty.store(true);
+    frame.pin_count.store(1);
+    frame_id_t local = frame_id - shard.first_frame;
+    shard.replacer->RecordPageLoad(local, page_id);
+    shard.replacer->RecordAccess(local, AccessType::RANDOM);
+    shard.replacer->Unpin(local);
+    return &frame.page;
+}
+
+bool BufferPool::DeletePage(page_id_t page_id) {
+    Shard& shard = GetShard(page_id);
+    std::unique_lock<std::mutex> lock(shard.latch);
+    frame_id_t frame_id = shard.page_table.Find(page_id);
+    if (frame_id != ConcurrentPageTable::NOT_FOUND) {
+        Frame& frame = frames_[frame_id];
+        int unpinned = 0;
+        if (!frame.pin_count.compare_exchange_strong(unpinned, EVICTING)) return false;
+        shard.page_table.Erase(page_id);
+        frame.page_id.store(INVALID_PAGE_ID);
+        frame.page.Init(INVALID_PAGE_ID);
+        frame.is_dirty.store(false);
+        frame.prefetched.store(false);
+        frame.referenced.store(false);
+        if (!IsRingFrame(frame_id)) {
+            shard.replacer->Remove(frame_id - shard.first_frame);
+            shard.free_list.push_back(frame_id);
+        }
+        frame.pin_count.store(0);
+    }
+    disk_manager_->DeallocatePage(page_id);
+    return true;
+}
+
+void BufferPool::FlushAllPages() {
+    std::vector<frame_id_t> dirty;
+    for (size_t i = 0; i < pool_size_; ++i) {
+        if (frames_[i].page_id.load() != INVALID_PAGE_ID && frames_[i].is_dirty.load()) {
+            dirty.push_back(static_cast<frame_id_t>(i));
+        }
+    }
+    WriteBackFrames(dirty);
+}
+
+size_t BufferPool::PrefetchPages(page_id_t first_page_id, size_t num_pages, AccessType access_type) {
+    std::vector<page_id_t> page_ids(num_pages);
+    for (size_t i = 0; i < num_pages; ++i) page_ids[i] = first_page_id + static_cast<page_id_t>(i);
+    return PrefetchPages(page_ids, access_type);
+}
+
+size_t BufferPool::PrefetchPages(const std::vector<page_id_t>& page_ids, AccessType access_type) {
+    size_t issued = 0;
+    for (page_id_t page_id : page_ids) {
+        Shard& shard = GetShard(page_id);
+        frame_id_t frame_id = -1;
+        if (access_type == AccessType::SEQUENTIAL && !scan_ring_.frames.empty()) {
+            if (shard.page_table.Find(page_id) != ConcurrentPageTable::NOT_FOUND) continue;
+            frame_id = GetRingFrame();
+        }
+        std::unique_lock<std::mutex> lock(shard.latch);
+        if (shard.page_table.Find(page_id) != ConcurrentPageTable::NOT_FOUND) {
+            if (frame_id != -1) frames_[frame_id].pin_count.store(0);
+            continue;
+        }
+        if (frame_id == -1) {
+            if (!shard.free_list.empty()) {
+                frame_id = shard.free_list.front();
+                shard.free_list.pop_front();
+            } else {
+                frame_id = GetVictimFrame(shard, false);
+                if (frame_id == -1) continue;
+            }
+        }
+
+        InstallPage(shard, frame_id, page_id);
+        Frame& frame = frames_[frame_id];
+        frame.io_in_progress.store(true);
+        frame.prefetched.store(true);
+        if (!IsRingFrame(frame_id)) {
+            frame_id_t local = frame_id - shard.first_frame;
+            shard.replacer->RecordPageLoad(local, page_id);
+            shard.replacer->Unpin(local);
+        }
+        // The frame stays claimed (EVICTING) until the read completes
+        bool queued = disk_manager_->ReadPageAsync(
+            page_id, frame.page.GetData(), [this, frame_id](page_id_t loaded, int) {
+                Shard& owner = GetShard(loaded);
+                std::lock_guard<std::mutex> guard(owner.latch);
+                frames_[frame_id].io_in_progress.store(false);
+                frames_[frame_id].pin_count.store(0);
+                owner.io_cv.notify_all();
+            });
+        if (!queued) {
+            frame.io_in_progress.store(false);
+            frame.pin_count.store(0);
+            continue;
+        }
+        ++issued;
+    }
+    if (issued > 0) {
+        prefetch_issued_.fetch_add(issued);
+        disk_manager_->SubmitIO();
+        // Runs the callbacks of whatever has completed; never blocks
+        disk_manager_->WaitForIO(0);
+    }
+    return issued;
+}
+
+BufferPoolStats BufferPool::GetStats() const {
+    BufferPoolStats stats;
+    stats.replacer_type = replacer_type_;
+    stats.hits = hits_.load();
+    stats.latch_free_hits = latch_free_hits_.load();
+    stats.misses = misses_.load();
+    stats.evictions = evictions_.load();
+    stats.ring_hits = ring_hits_.load();
+    stats.ring_misses = ring_misses_.load();
+    stats.prefetch_issued = prefetch_issued_.load();
+    stats.prefetch_hits = prefetch_hits_.load();
+    stats.dirty_evictions = dirty_evictions_.load();
+    return stats;
+}
+
+void BufferPool::ResetStats() {
+    hits_ = 0;
+    latch_free_hits_ = 0;
+    misses_ = 0;
+    evictions_ = 0;
+    ring_hits_ = 0;
+    ring_misses_ = 0;
+    prefetch_issued_ = 0;
+    prefetch_hits_ = 0;
+    dirty_evictions_ = 0;
+}
+
+frame_id_t BufferPool::GetVictimFrame(Shard& shard, bool allow_dirty) {
+    // Every candidate is offered back to the replacer once, plus one
+    // more pass for frames that used their second chance
+    for (size_t attempt = 0; attempt < 2 * shard.num_frames + 1; ++attempt) {
+        frame_id_t local;
+        if (!shard.replacer->Victim(&local)) return -1;
+        frame_id_t frame_id = shard.first_frame + local;
+        Frame& frame = frames_[frame_id];
+
+        if (frame.referenced.exchange(false)) {
+            shard.replacer->RecordAccess(local, AccessType::RANDOM);
+            shard.replacer->Unpin(local);
+            continue;
+        }
+        bool dirty = frame.is_dirty.load();
+        bool wal_blocked = dirty && log_manager_ != nullptr &&
+                           frame.page.GetLSN() > log_manager_->GetPersistentLSN();
+        int unpinned = 0;
+        if ((dirty && !allow_dirty) || wal_blocked ||
+            !frame.pin_count.compare_exchange_strong(unpinned, EVICTING)) {
+            shard.replacer->Unpin(local);
+            continue;
+        }
+
+        page_id_t old_page_id = frame.page_id.load();
+        if (frame.is_dirty.load()) {
+            // Inline write on the fetching thread: the background writer
+            // fell behind
+            disk_manager_->WritePage(old_page_id, frame.page.GetData());
+            frame.is_dirty.store(false);
+            dirty_evictions_.fetch_add(1);
+            if (bg_writer_ != nullptr) bg_writer_->Wakeup();
+        }
+        shard.page_table.Erase(old_page_id);
+        frame.page_id.store(INVALID_PAGE_ID);
+        evictions_.fetch_add(1);
+        return frame_id;
+    }
+    return -1;
+}
+
+frame_id_t BufferPool::GetRingFrame() {
+    std::lock_guard<std::mutex> ring_lock(scan_ring_.latch);
+    size_t ring_size = scan_ring_.frames.size();
+    for (size_t attempt = 0; attempt < 2 * ring_size; ++attempt) {
+        frame_id_t frame_id = scan_ring_.frames[scan_ring_.next];
+        scan_ring_.next = (scan_ring_.next + 1) % ring_size;
+        Frame& frame = frames_[frame_id];
+
+        page_id_t old_page_id = frame.page_id.load();
+        int unpinned = 0;
+        if (old_page_id == INVALID_PAGE_ID) {
+            if (frame.pin_count.compare_exchange_strong(unpinned, EVICTING)) return frame_id;
+            continue;
+        }
+
+        Shard& owner = GetShard(old_page_id);
+        std::lock_guard<std::mutex> lock(owner.latch);
+        if (frame.page_id.load() != old_page_id) continue;
+        bool wal_blocked = frame.is_dirty.load() && log_manager_ != nullptr &&
+                           frame.page.GetLSN() > log_manager_->GetPersistentLSN();
+        if (wal_blocked || !frame.pin_count.compare_exchange_strong(unpinned, EVICTING)) continue;
+        if (frame.is_dirty.load()) {
+            disk_manager_->WritePage(old_page_id, frame.page.GetData());
+            frame.is_dirty.store(false);
+            dirty_evictions_.fetch_add(1);
+        }
+        owner.page_table.Erase(old_page_id);
+        frame.page_id.store(INVALID_PAGE_ID);
+        evictions_.fetch_add(1);
+        return frame_id;
+    }
+    return -1;
+}
+
+void BufferPool::InstallPage(Shard& shard, frame_id_t frame_id, page_id_t page_id) {
+    Frame& frame = frames_[frame_id];
+    // Free frames are claimed here; a stale latch-free pin on one backs
+    // off as soon as it sees the page_id, so wait it out
+    int unpinned = 0;
+    while (!frame.pin_count.compare_exchange_weak(unpinned, EVICTING) && unpinned != EVICTING) {
+        unpinned = 0;
+    }
+    frame.page.Init(page_id);
+    frame.is_dirty.store(false);
+    frame.prefetched.store(false);
+    frame.referenced.store(false);
+    frame.page_id.store(page_id);
+    shard.page_table.Insert(page_id, frame_id);
+}
+
+void BufferPool::ReadFrame(Shard& shard, std::unique_lock<std::mutex>& lock, frame_id_t frame_id) {
+    Frame& frame = frames_[frame_id];
+    frame.io_in_progress.store(true);
+    lock.unlock();
+    disk_manager_->ReadPage(frame.page_id.load(), frame.page.GetData());
+    lock.lock();
+    frame.io_in_progress.store(false);
+    shard.io_cv.notify_all();
+}
+
+void BufferPool::WaitForFrameIO(Shard& shard, std::unique_lock<std::mutex>& lock, frame_id_t frame_id) {
+    Frame& frame = frames_[frame_id];
+    while (frame.io_in_progress.load()) {
+        // A prefetch completes only when someone reaps it
+        lock.unlock();
+        size_t reaped = disk_manager_->WaitForIO(1);
+        lock.lock();
+        if (reaped == 0 && frame.io_in_progress.load()) {
+            shard.io_cv.wait_for(lock, std::chrono::milliseconds(1));
+        }
+    }
+}
+
+void BufferPool::WriteBackFrames(const std::vector<frame_id_t>& frame_ids) {
+    // Pages are copied out under their shard latch and written as one
+    // async batch, so a long flush never holds a latch across I/O
+    if (frame_ids.empty()) return;
+    AlignedPageBuffer buffer = AllocateAlignedPages(frame_ids.size());
+    std::vector<DirtyFrameSnapshot> snapshots;
+    for (frame_id_t frame_id : frame_ids) {
+        Frame& frame = frames_[frame_id];
+        page_id_t page_id = frame.page_id.load();
+        if (page_id == INVALID_PAGE_ID) continue;
+        Shard& shard = GetShard(page_id);
+        std::lock_guard<std::mutex> lock(shard.latch);
+        if (frame.page_id.load() != page_id || !frame.is_dirty.load() || frame.io_in_progress.load()) continue;
+        if (log_manager_ != nullptr && frame.page.GetLSN() > log_manager_->GetPersistentLSN()) continue;
+        char* data = buffer.get() + snapshots.size() * PAGE_SIZE;
+        std::memcpy(data, frame.page.GetData(), PAGE_SIZE);
+        snapshots.push_back({frame_id, page_id, frame.dirty_version.load(), data});
+    }
+
+    // Another thread reaping completions may run our callbacks, so wait
+    // for all of them rather than for an empty queue
+    std::vector<int> results(snapshots.size(), -1);
+    std::atomic<size_t> completed(0);
+    size_t issued = 0;
+    for (size_t i = 0; i < snapshots.size(); ++i) {
+        auto callback = [&results, &completed, i](page_id_t, int result) {
+            results[i] = result;
+            completed.fetch_add(1, std::memory_order_release);
+        };
+        if (disk_manager_->WritePageAsync(snapshots[i].page_id, snapshots[i].data, callback)) ++issued;
+    }
+    disk_manager_->DrainIO();
+    while (completed.load(std::memory_order_acquire) < issued) std::this_thread::yield();
+    for (size_t i = 0; i < snapshots.size(); ++i) {
+        if (results[i] == 0) MarkFrameClean(snapshots[i]);
+    }
+}
+
+size_t BufferPool::CollectDirtyFrames(size_t max_frames, char* buffer,
+                                      std::vector<DirtyFrameSnapshot>* snapshots,
+                                      size_t* skipped_wal) {
+    // Candidates first, unreferenced before referenced, then copied in
+    // page_id order so adjacent pages end up adjacent in `buffer`
+    struct Candidate {
+        bool referenced;
+        page_id_t page_id;
+        frame_id_t frame_id;
+    };
+    std::vector<Candidate> candidates;
+    for (size_t i = 0; i < pool_size_; ++i) {
+        const Frame& frame = frames_[i];
+        page_id_t page_id = frame.page_id.load();
+        if (page_id == INVALID_PAGE_ID || !frame.is_dirty.load() || frame.pin_count.load() != 0) {
+            continue;
+        }
+        if (log_manager_ != nullptr && frame.page.GetLSN() > log_manager_->GetPersistentLSN()) {
+            ++*skipped_wal;
+            continue;
+        }
+        candidates.push_back({frame.referenced.load(), page_id, static_cast<frame_id_t>(i)});
+    }
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const Candidate& a, const Candidate& b) { return a.referenced < b.referenced; });
+    if (candidates.size() > max_frames) candidates.resize(max_frames);
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Candidate& a, const Candidate& b) { return a.page_id < b.page_id; });
+
+    size_t collected = 0;
+    for (const Candidate& candidate : candidates) {
+        Frame& frame = frames_[candidate.frame_id];
+        page_id_t page_id = candidate.page_id;
+        Shard& shard = GetShard(page_id);
+        std::lock_guard<std::mutex> lock(shard.latch);
+        if (frame.page_id.load() != page_id || !frame.is_dirty.load() ||
+            frame.pin_count.load() != 0 || frame.io_in_progress.load()) {
+            continue;
+        }
+        char* data = buffer + collected * PAGE_SIZE;
+        std::memcpy(data, frame.page.GetData(), PAGE_SIZE);
+        snapshots->push_back({candidate.frame_id, page_id, frame.dirty_version.load(), data});
+        ++collected;
+    }
+    return collected;
+}
+
+bool BufferPool::MarkFrameClean(const DirtyFrameSnapshot& snapshot) {
+    Shard& shard = GetShard(snapshot.page_id);
+    std::lock_guard<std::mutex> lock(shard.latch);
+    Frame& frame = frames_[snapshot.frame_id];
+    if (frame.page_id.load() != snapshot.page_id ||
+        frame.dirty_version.load() != snapshot.dirty_version) {
+        return false;
+    }
+    frame.is_dirty.store(false);
+    return true;
+}
+
+size_t BufferPool::NumCleanEvictable() {
+    size_t clean = 0;
+    for (size_t i = 0; i < pool_size_; ++i) {
+        const Frame& frame = frames_[i];
+        if (frame.page_id.load() == INVALID_PAGE_ID || (frame.pin_count.load() == 0 && !frame.is_dirty.load())) {
+            ++clean;
+        }
+    }
+    return clean;
+}
+
+} // namespace mokshith
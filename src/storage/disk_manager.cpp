@@ -0,0 +1,143 @@
+#include "storage/disk_manager.h"
+#include <stdexcept>
+
+namespace mokshith {
+
+DiskManager::DiskManager(const std::string& db_file, IOBackendType backend_type)
+    : db_file_name_(db_file),
+      io_backend_(CreateIOBackend(backend_type)),
+      num_reads_(0),
+      num_writes_(0),
+      num_flushes_(0) {
+    size_t dot = db_file_name_.rfind('.');
+    log_file_name_ = (dot == std::string::npos ? db_file_name_ : db_file_name_.substr(0, dot)) + ".log";
+
+    if (!io_backend_->Open(db_file_name_)) {
+        // O_DIRECT is not supported by every file system (tmpfs)
+        if (io_backend_->GetType() != IOBackendType::FSTREAM) {
+            io_backend_ = CreateIOBackend(IOBackendType::FSTREAM);
+        }
+        if (!io_backend_->Open(db_file_name_)) {
+            throw std::runtime_error("DiskManager: cannot open " + db_file_name_);
+        }
+    }
+    next_page_id_ = static_cast<page_id_t>(GetFileSize() / PAGE_SIZE);
+}
+
+DiskManager::~DiskManager() {
+    DrainIO();
+    io_backend_->Sync();
+    io_backend_->Close();
+    std::lock_guard<std::mutex> lock(log_io_mutex_);
+    if (log_file_.is_open()) log_file_.close();
+}
+
+void DiskManager::ReadPage(page_id_t page_id, char* page_data) {
+    io_backend_->Read(page_id, page_data, 1);
+    num_reads_.fetch_add(1);
+}
+
+void DiskManager::WritePage(page_id_t page_id, const char* page_data) {
+    io_backend_->Write(page_id, page_data, 1);
+    num_writes_.fetch_add(1);
+}
+
+page_id_t DiskManager::AllocatePage() {
+    return next_page_id_.fetch_add(1);
+}
+
+void DiskManager::DeallocatePage(page_id_t /*page_id*/) {
+    // Pages are not reused; the free-space map tracks empty heap pages
+}
+
+bool DiskManager::ReadPageAsync(page_id_t page_id, char* page_data, IOCallback callback) {
+    IORequest request;
+    request.op = IOOpType::READ;
+    request.page_id = page_id;
+    request.read_buffer = page_data;
+    request.num_pages = 1;
+    request.callback = std::move(callback);
+    if (!io_backend_->Prepare(std::move(request))) return false;
+    num_reads_.fetch_add(1);
+    return true;
+}
+
+bool DiskManager::WritePageAsync(page_id_t page_id, const char* page_data, IOCallback callback) {
+    return WritePagesAsync(page_id, page_data, 1, std::move(callback));
+}
+
+bool DiskManager::WritePagesAsync(page_id_t first_page_id, const char* data,
+                                  size_t num_pages, IOCallback callback) {
+    IORequest request;
+    request.op = IOOpType::WRITE;
+    request.page_id = first_page_id;
+    request.write_buffer = data;
+    request.num_pages = num_pages;
+    request.callback = std::move(callback);
+    if (!io_backend_->Prepare(std::move(request))) return false;
+    num_writes_.fetch_add(num_pages);
+    return true;
+}
+
+size_t DiskManager::SubmitIO() {
+    return io_backend_->Submit();
+}
+
+size_t DiskManager::WaitForIO(size_t min_completions) {
+    return io_backend_->Reap(min_completions);
+}
+
+void DiskManager::DrainIO() {
+    io_backend_->Submit();
+    do {
+        io_backend_->Reap(io_backend_->InFlight());
+    } while (io_backend_->InFlight() > 0);
+}
+
+bool DiskManager::OpenLogFile() {
+    if (log_file_.is_open()) return true;
+    // Append mode creates the file; reads still seek freely
+    log_file_.open(log_file_name_, std::ios::binary | std::ios::in | std::ios::out | std::ios::app);
+    return log_file_.is_open();
+}
+
+void DiskManager::WriteLog(const char* log_data, size_t size) {
+    std::lock_guard<std::mutex> lock(log_io_mutex_);
+    if (size == 0 || !OpenLogFile()) return;
+    log_file_.clear();
+    log_file_.write(log_data, static_cast<std::streamsize>(size));
+}
+
+void DiskManager::FlushLog() {
+    std::lock_guard<std::mutex> lock(log_io_mutex_);
+    if (!log_file_.is_open()) return;
+    log_file_.flush();
+    num_flushes_.fetch_add(1);
+}
+
+bool DiskManager::ReadLog(char* log_data, size_t size, size_t offset, size_t* bytes_read) {
+    std::lock_guard<std::mutex> lock(log_io_mutex_);
+    *bytes_read = 0;
+    if (!OpenLogFile()) return false;
+    log_file_.flush();
+    log_file_.clear();
+    log_file_.seekg(static_cast<std::streamoff>(offset));
+    log_file_.read(log_data, static_cast<std::streamsize>(size));
+    *bytes_read = log_file_.gcount() > 0 ? static_cast<size_t>(log_file_.gcount()) : 0;
+    log_file_.clear();
+    return *bytes_read > 0;
+}
+
+size_t DiskManager::GetFileSize() const {
+    std::ifstream file(db_file_name_, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) return 0;
+    std::streamoff size = file.tellg();
+    return size > 0 ? static_cast<size_t>(size) : 0;
+}
+
+void DiskManager::Flush() {
+    std::lock_guard<std::mutex> lock(db_io_mutex_);
+    io_backend_->Sync();
+}
+
+} // namespace mokshith
@@ -0,0 +1,323 @@
+#include "storage/io_backend.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifdef MOKSHITH_HAVE_IO_URING
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace mokshith {
+
+namespace {
+
+// Positional I/O on the shared fstream; the caller holds its mutex.
+// Pages past the end of the file read as zeros.
+int ReadAt(std::fstream& file, page_id_t page_id, char* buffer, size_t num_pages) {
+    size_t size = num_pages * PAGE_SIZE;
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(page_id) * PAGE_SIZE);
+    file.read(buffer, static_cast<std::streamsize>(size));
+    size_t read = file.gcount() > 0 ? static_cast<size_t>(file.gcount()) : 0;
+    if (read < size) std::memset(buffer + read, 0, size - read);
+    file.clear();
+    return 0;
+}
+
+int WriteAt(std::fstream& file, page_id_t page_id, const char* buffer, size_t num_pages) {
+    file.clear();
+    file.seekp(static_cast<std::streamoff>(page_id) * PAGE_SIZE);
+    file.write(buffer, static_cast<std::streamsize>(num_pages * PAGE_SIZE));
+    if (!file.good()) {
+        file.clear();
+        return -EIO;
+    }
+    return 0;
+}
+
+} // namespace
+
+IOStats IOBackend::GetStats() const {
+    IOStats stats;
+    stats.num_reads = num_reads_.load();
+    stats.num_writes = num_writes_.load();
+    stats.num_syncs = num_syncs_.load();
+    stats.num_submits = num_submits_.load();
+    stats.num_submitted = num_submitted_.load();
+    stats.num_completions = num_completions_.load();
+    stats.bytes_read = bytes_read_.load();
+    stats.bytes_written = bytes_written_.load();
+    stats.max_in_flight = max_in_flight_.load();
+    return stats;
+}
+
+void IOBackend::RecordSubmit(size_t count) {
+    if (count == 0) return;
+    num_submits_.fetch_add(1);
+    num_submitted_.fetch_add(count);
+    uint64_t in_flight = in_flight_.fetch_add(count) + count;
+    uint64_t max = max_in_flight_.load();
+    while (in_flight > max && !max_in_flight_.compare_exchange_weak(max, in_flight)) {
+    }
+}
+
+void IOBackend::RecordCompletion(const IORequest& request) {
+    uint64_t bytes = request.num_pages * PAGE_SIZE;
+    if (request.op == IOOpType::READ) {
+        num_reads_.fetch_add(1);
+        bytes_read_.fetch_add(bytes);
+    } else {
+        num_writes_.fetch_add(1);
+        bytes_written_.fetch_add(bytes);
+    }
+    num_completions_.fetch_add(1);
+    in_flight_.fetch_sub(1);
+}
+
+// FStreamIOBackend
+
+FStreamIOBackend::~FStreamIOBackend() {
+    Close();
+}
+
+bool FStreamIOBackend::Open(const std::string& file_name) {
+    std::lock_guard<std::mutex> lock(io_mutex_);
+    file_.open(file_name, std::ios::binary | std::ios::in | std::ios::out);
+    if (!file_.is_open()) {
+        // Create the file, then reopen it for reading and writing
+        file_.clear();
+        file_.open(file_name, std::ios::binary | std::ios::trunc | std::ios::out);
+        file_.close();
+        file_.open(file_name, std::ios::binary | std::ios::in | std::ios::out);
+    }
+    return file_.is_open();
+}
+
+void FStreamIOBackend::Close() {
+    std::lock_guard<std::mutex> lock(io_mutex_);
+    if (file_.is_open()) {
+        file_.flush();
+        file_.close();
+    }
+}
+
+int FStreamIOBackend::Read(page_id_t page_id, char* buffer, size_t num_pages) {
+    int result;
+    {
+        std::lock_guard<std::mutex> lock(io_mutex_);
+        result = ReadAt(file_, page_id, buffer, num_pages);
+    }
+    num_reads_.fetch_add(1);
+    bytes_read_.fetch_add(num_pages * PAGE_SIZE);
+    return result;
+}
+
+int FStreamIOBackend::Write(page_id_t page_id, const char* buffer, size_t num_pages) {
+    int result;
+    {
+        std::lock_guard<std::mutex> lock(io_mutex_);
+        result = WriteAt(file_, page_id, buffer, num_pages);
+    }
+    num_writes_.fetch_add(1);
+    bytes_written_.fetch_add(num_pages * PAGE_SIZE);
+    return result;
+}
+
+int FStreamIOBackend::Sync() {
+    std::lock_guard<std::mutex> lock(io_mutex_);
+    file_.flush();
+    num_syncs_.fetch_add(1);
+    return file_.good() ? 0 : -EIO;
+}
+
+bool FStreamIOBackend::Prepare(IORequest request) {
+    std::lock_guard<std::mutex> lock(queue_latch_);
+    pending_.push_back(std::move(request));
+    return true;
+}
+
+size_t FStreamIOBackend::Submit() {
+    std::vector<IORequest> batch;
+    {
+        std::lock_guard<std::mutex> lock(queue_latch_);
+        batch.swap(pending_);
+    }
+    RecordSubmit(batch.size());
+
+    std::vector<std::pair<IORequest, int>> done;
+    done.reserve(batch.size());
+    {
+        std::lock_guard<std::mutex> lock(io_mutex_);
+        for (auto& request : batch) {
+            int result = request.op == IOOpType::READ
+                             ? ReadAt(file_, request.page_id, request.read_buffer, request.num_pages)
+                             : WriteAt(file_, request.page_id, request.write_buffer, request.num_pages);
+            done.emplace_back(std::move(request), result);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(queue_latch_);
+    for (auto& entry : done) completed_.push_back(std::move(entry));
+    return batch.size();
+}
+
+size_t FStreamIOBackend::Reap(size_t /*min_completions*/) {
+    // Requests complete in Submit(), so whatever is done is all there is
+    std::vector<std::pair<IORequest, int>> done;
+    {
+        std::lock_guard<std::mutex> lock(queue_latch_);
+        done.swap(completed_);
+    }
+    for (auto& entry : done) {
+        RecordCompletion(entry.first);
+        if (entry.first.callback) entry.first.callback(entry.first.page_id, entry.second);
+    }
+    return done.size();
+}
+
+#ifdef MOKSHITH_HAVE_IO_URING
+// IOUringIOBackend
+
+IOUringIOBackend::IOUringIOBackend(unsigned queue_depth)
+    : IOBackend(IOBackendType::IO_URING), fd_(-1), queue_depth_(queue_depth), prepared_(0) {
+    std::memset(&ring_, 0, sizeof(ring_));
+}
+
+IOUringIOBackend::~IOUringIOBackend() {
+    Close();
+}
+
+bool IOUringIOBackend::Open(const std::string& file_name) {
+    fd_ = ::open(file_name.c_str(), O_RDWR | O_CREAT | O_DIRECT, 0644);
+    if (fd_ < 0) return false;
+    if (io_uring_queue_init(queue_depth_, &ring_, 0) < 0) {
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+    return true;
+}
+
+void IOUringIOBackend::Close() {
+    if (fd_ < 0) return;
+    while (InFlight() > 0) Reap(InFlight());
+    io_uring_queue_exit(&ring_);
+    ::close(fd_);
+    fd_ = -1;
+}
+
+int IOUringIOBackend::Read(page_id_t page_id, char* buffer, size_t num_pages) {
+    size_t size = num_pages * PAGE_SIZE;
+    off_t offset = static_cast<off_t>(page_id) * PAGE_SIZE;
+    size_t done = 0;
+    while (done < size) {
+        ssize_t n = ::pread(fd_, buffer + done, size - done, offset + done);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -errno;
+        }
+        if (n == 0) {
+            std::memset(buffer + done, 0, size - done);
+            break;
+        }
+        done += static_cast<size_t>(n);
+    }
+    num_reads_.fetch_add(1);
+    bytes_read_.fetch_add(size);
+    return 0;
+}
+
+int IOUringIOBackend::Write(page_id_t page_id, const char* buffer, size_t num_pages) {
+    size_t size = num_pages * PAGE_SIZE;
+    off_t offset = static_cast<off_t>(page_id) * PAGE_SIZE;
+    size_t done = 0;
+    while (done < size) {
+        ssize_t n = ::pwrite(fd_, buffer + done, size - done, offset + done);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -errno;
+        }
+        done += static_cast<size_t>(n);
+    }
+    num_writes_.fetch_add(1);
+    bytes_written_.fetch_add(size);
+    return 0;
+}
+
+int IOUringIOBackend::Sync() {
+    num_syncs_.fetch_add(1);
+    return ::fdatasync(fd_) == 0 ? 0 : -errno;
+}
+
+bool IOUringIOBackend::Prepare(IORequest request) {
+    std::lock_guard<std::mutex> lock(sq_latch_);
+    struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+    if (sqe == nullptr) return false;
+    auto* owned = new IORequest(std::move(request));
+    unsigned size = static_cast<unsigned>(owned->num_pages * PAGE_SIZE);
+    off_t offset = static_cast<off_t>(owned->page_id) * PAGE_SIZE;
+    if (owned->op == IOOpType::READ) {
+        io_uring_prep_read(sqe, fd_, owned->read_buffer, size, offset);
+    } else {
+        io_uring_prep_write(sqe, fd_, owned->write_buffer, size, offset);
+    }
+    io_uring_sqe_set_data(sqe, owned);
+    ++prepared_;
+    return true;
+}
+
+size_t IOUringIOBackend::Submit() {
+    std::lock_guard<std::mutex> lock(sq_latch_);
+    if (prepared_ == 0) return 0;
+    int submitted = io_uring_submit(&ring_);
+    if (submitted < 0) return 0;
+    RecordSubmit(static_cast<size_t>(submitted));
+    prepared_ -= std::min(prepared_, static_cast<size_t>(submitted));
+    return static_cast<size_t>(submitted);
+}
+
+size_t IOUringIOBackend::Reap(size_t min_completions) {
+    std::vector<std::pair<IORequest*, int>> done;
+    {
+        std::lock_guard<std::mutex> lock(cq_latch_);
+        min_completions = std::min(min_completions, InFlight());
+        while (true) {
+            struct io_uring_cqe* cqe = nullptr;
+            int ret = done.size() < min_completions ? io_uring_wait_cqe(&ring_, &cqe)
+                                                    : io_uring_peek_cqe(&ring_, &cqe);
+            if (ret < 0 || cqe == nullptr) break;
+            auto* request = static_cast<IORequest*>(io_uring_cqe_get_data(cqe));
+            int result = cqe->res < 0 ? cqe->res : 0;
+            size_t size = request->num_pages * PAGE_SIZE;
+            if (result == 0 && static_cast<size_t>(cqe->res) < size) {
+                // Short read at the end of the file: the rest reads as zeros
+                if (request->op == IOOpType::READ) {
+                    std::memset(request->read_buffer + cqe->res, 0, size - cqe->res);
+                } else {
+                    result = -EIO;
+                }
+            }
+            io_uring_cqe_seen(&ring_, cqe);
+            done.emplace_back(request, result);
+        }
+    }
+    for (auto& entry : done) {
+        RecordCompletion(*entry.first);
+        if (entry.first->callback) entry.first->callback(entry.first->page_id, entry.second);
+        delete entry.first;
+    }
+    return done.size();
+}
+#endif
+
+std::unique_ptr<IOBackend> CreateIOBackend(IOBackendType type) {
+#ifdef MOKSHITH_HAVE_IO_URING
+    if (type == IOBackendType::IO_URING) return std::make_unique<IOUringIOBackend>();
+#else
+    (void)type;
+#endif
+    return std::make_unique<FStreamIOBackend>();
+}
+
+} // namespace mokshith
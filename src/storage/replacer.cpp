@@ -0,0 +1,269 @@
+#include "storage/replacer.h"
+#include <algorithm>
+#include <limits>
+
+namespace mokshith {
+
+// LRUReplacer
+
+LRUReplacer::LRUReplacer(size_t num_frames) {
+    lru_map_.reserve(num_frames);
+}
+
+void LRUReplacer::RecordAccess(frame_id_t frame_id, AccessType /*access_type*/) {
+    // Evictable frames move to the most recently used end
+    auto it = lru_map_.find(frame_id);
+    if (it == lru_map_.end()) return;
+    lru_list_.splice(lru_list_.end(), lru_list_, it->second);
+}
+
+bool LRUReplacer::Victim(frame_id_t* frame_id) {
+    if (lru_list_.empty()) return false;
+    *frame_id = lru_list_.front();
+    lru_map_.erase(*frame_id);
+    lru_list_.pop_front();
+    return true;
+}
+
+void LRUReplacer::Pin(frame_id_t frame_id) {
+    auto it = lru_map_.find(frame_id);
+    if (it == lru_map_.end()) return;
+    lru_list_.erase(it->second);
+    lru_map_.erase(it);
+}
+
+void LRUReplacer::Unpin(frame_id_t frame_id) {
+    if (lru_map_.count(frame_id) != 0) return;
+    lru_list_.push_back(frame_id);
+    lru_map_[frame_id] = std::prev(lru_list_.end());
+}
+
+void LRUReplacer::Remove(frame_id_t frame_id) {
+    Pin(frame_id);
+}
+
+// LRUKReplacer
+
+LRUKReplacer::LRUKReplacer(size_t num_frames, size_t k)
+    : k_(k), current_timestamp_(0), evictable_count_(0), history_(num_frames) {}
+
+void LRUKReplacer::RecordAccess(frame_id_t frame_id, AccessType /*access_type*/) {
+    auto& timestamps = history_[frame_id].timestamps;
+    timestamps.push_front(current_timestamp_++);
+    if (timestamps.size() > k_) timestamps.pop_back();
+}
+
+bool LRUKReplacer::Victim(frame_id_t* frame_id) {
+    // Frames with fewer than K accesses have +inf distance; among them,
+    // and among the rest, the oldest K-th access goes first
+    bool found = false;
+    bool best_infinite = false;
+    uint64_t best_timestamp = std::numeric_limits<uint64_t>::max();
+    for (size_t i = 0; i < history_.size(); ++i) {
+        const FrameHistory& frame = history_[i];
+        if (!frame.evictable) continue;
+        bool infinite = frame.timestamps.size() < k_;
+        uint64_t timestamp = frame.timestamps.empty() ? 0 : frame.timestamps.back();
+        if (!found || (infinite && !best_infinite) ||
+            (infinite == best_infinite && timestamp < best_timestamp)) {
+            found = true;
+            best_infinite = infinite;
+            best_timestamp = timestamp;
+            *frame_id = static_cast<frame_id_t>(i);
+        }
+    }
+    if (!found) return false;
+    Remove(*frame_id);
+    return true;
+}
+
+void LRUKReplacer::Pin(frame_id_t frame_id) {
+    FrameHistory& frame = history_[frame_id];
+    if (!frame.evictable) return;
+    frame.evictable = false;
+    --evictable_count_;
+}
+
+void LRUKReplacer::Unpin(frame_id_t frame_id) {
+    FrameHistory& frame = history_[frame_id];
+    if (frame.evictable) return;
+    frame.evictable = true;
+    ++evictable_count_;
+}
+
+void LRUKReplacer::Remove(frame_id_t frame_id) {
+    FrameHistory& frame = history_[frame_id];
+    if (frame.evictable) --evictable_count_;
+    frame.evictable = false;
+    frame.timestamps.clear();
+}
+
+// TwoQReplacer
+
+TwoQReplacer::TwoQReplacer(size_t num_frames, double a1in_ratio, double a1out_ratio)
+    : a1in_max_(std::max<size_t>(1, static_cast<size_t>(num_frames * a1in_ratio))),
+      a1out_max_(std::max<size_t>(1, static_cast<size_t>(num_frames * a1out_ratio))),
+      evictable_count_(0),
+      frames_(num_frames) {}
+
+void TwoQReplacer::RecordPageLoad(frame_id_t frame_id, page_id_t page_id) {
+    FrameState& frame = frames_[frame_id];
+    frame.page_id = page_id;
+    auto it = a1out_map_.find(page_id);
+    if (it == a1out_map_.end()) return;
+    // Seen again shortly after leaving A1in: part of the hot set
+    a1out_.erase(it->second);
+    a1out_map_.erase(it);
+    if (frame.queue == Queue::A1IN) a1in_.erase(frame.pos);
+    if (frame.queue == Queue::AM) am_.erase(frame.pos);
+    am_.push_back(frame_id);
+    frame.queue = Queue::AM;
+    frame.pos = std::prev(am_.end());
+}
+
+void TwoQReplacer::RecordAccess(frame_id_t frame_id, AccessType access_type) {
+    FrameState& frame = frames_[frame_id];
+    switch (frame.queue) {
+        case Queue::NONE:
+            a1in_.push_back(frame_id);
+            frame.queue = Queue::A1IN;
+            frame.pos = std::prev(a1in_.end());
+            break;
+        case Queue::A1IN:
+            // Re-referenced while on probation. Scans touch a page several
+            // times in a row, which says nothing about reuse.
+            if (access_type == AccessType::RANDOM) {
+                a1in_.erase(frame.pos);
+                am_.push_back(frame_id);
+                frame.queue = Queue::AM;
+                frame.pos = std::prev(am_.end());
+            }
+            break;
+        case Queue::AM:
+            am_.splice(am_.end(), am_, frame.pos);
+            break;
+    }
+}
+
+bool TwoQReplacer::Victim(frame_id_t* frame_id) {
+    // Probation frames go first. Am gives up frames only while it holds
+    // more than its share (all but a1in_max_ frames) or A1in has nothing
+    // evictable, so a scan cycles through A1in and leaves Am alone.
+    auto first_evictable = [this](const std::list<frame_id_t>& queue) {
+        return std::find_if(queue.begin(), queue.end(),
+                            [this](frame_id_t f) { return frames_[f].evictable; });
+    };
+    auto a1in_victim = first_evictable(a1in_);
+    auto am_victim = first_evictable(am_);
+    bool am_over_share = am_.size() + a1in_max_ > frames_.size();
+    bool from_a1in;
+    if (a1in_victim != a1in_.end() && !(am_over_share && am_victim != am_.end())) {
+        from_a1in = true;
+    } else if (am_victim != am_.end()) {
+        from_a1in = false;
+    } else {
+        // Evictable frames that were never accessed
+        for (size_t i = 0; i < frames_.size(); ++i) {
+            if (frames_[i].evictable && frames_[i].queue == Queue::NONE) {
+                *frame_id = static_cast<frame_id_t>(i);
+                Remove(*frame_id);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    *frame_id = from_a1in ? *a1in_victim : *am_victim;
+    page_id_t page_id = frames_[*frame_id].page_id;
+    Remove(*frame_id);
+    if (from_a1in && page_id != INVALID_PAGE_ID && a1out_map_.count(page_id) == 0) {
+        a1out_.push_back(page_id);
+        a1out_map_[page_id] = std::prev(a1out_.end());
+        if (a1out_.size() > a1out_max_) {
+            a1out_map_.erase(a1out_.front());
+            a1out_.pop_front();
+        }
+    }
+    return true;
+}
+
+void TwoQReplacer::Pin(frame_id_t frame_id) {
+    FrameState& frame = frames_[frame_id];
+    if (!frame.evictable) return;
+    frame.evictable = false;
+    --evictable_count_;
+}
+
+void TwoQReplacer::Unpin(frame_id_t frame_id) {
+    FrameState& frame = frames_[frame_id];
+    if (frame.evictable) return;
+    frame.evictable = true;
+    ++evictable_count_;
+}
+
+void TwoQReplacer::Remove(frame_id_t frame_id) {
+    FrameState& frame = frames_[frame_id];
+    if (frame.queue == Queue::A1IN) a1in_.erase(frame.pos);
+    if (frame.queue == Queue::AM) am_.erase(frame.pos);
+    if (frame.evictable) --evictable_count_;
+    frame = FrameState();
+}
+
+// ClockReplacer
+
+ClockReplacer::ClockReplacer(size_t num_frames)
+    : num_frames_(num_frames), entries_(new ClockEntry[num_frames]), hand_(0), evictable_count_(0) {}
+
+void ClockReplacer::RecordAccess(frame_id_t frame_id, AccessType /*access_type*/) {
+    entries_[frame_id].referenced.store(true, std::memory_order_relaxed);
+}
+
+bool ClockReplacer::Victim(frame_id_t* frame_id) {
+    if (evictable_count_.load() == 0) return false;
+    // Two sweeps clear every reference bit, so a third finds a victim if
+    // any frame is still evictable
+    for (size_t step = 0; step < 3 * num_frames_; ++step) {
+        size_t pos = hand_.fetch_add(1) % num_frames_;
+        ClockEntry& entry = entries_[pos];
+        if (!entry.evictable.load()) continue;
+        if (entry.referenced.exchange(false)) continue;
+        bool expected = true;
+        if (entry.evictable.compare_exchange_strong(expected, false)) {
+            evictable_count_.fetch_sub(1);
+            *frame_id = static_cast<frame_id_t>(pos);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ClockReplacer::Pin(frame_id_t frame_id) {
+    bool expected = true;
+    if (entries_[frame_id].evictable.compare_exchange_strong(expected, false)) {
+        evictable_count_.fetch_sub(1);
+    }
+}
+
+void ClockReplacer::Unpin(frame_id_t frame_id) {
+    bool expected = false;
+    if (entries_[frame_id].evictable.compare_exchange_strong(expected, true)) {
+        evictable_count_.fetch_add(1);
+    }
+}
+
+void ClockReplacer::Remove(frame_id_t frame_id) {
+    Pin(frame_id);
+    entries_[frame_id].referenced.store(false);
+}
+
+std::unique_ptr<Replacer> CreateReplacer(ReplacerType type, size_t num_frames) {
+    switch (type) {
+        case ReplacerType::LRU_K: return std::make_unique<LRUKReplacer>(num_frames);
+        case ReplacerType::TWO_Q: return std::make_unique<TwoQReplacer>(num_frames);
+        case ReplacerType::CLOCK: return std::make_unique<ClockReplacer>(num_frames);
+        case ReplacerType::LRU: break;
+    }
+    return std::make_unique<LRUReplacer>(num_frames);
+}
+
+} // namespace mokshith
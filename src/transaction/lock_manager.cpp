@@ -0,0 +1,318 @@
+#include "transaction/lock_manager.h"
+#include <algorithm>
+#include <unordered_set>
+
+namespace mokshith {
+
+LockManager::LockManager(size_t escalation_threshold)
+    : escalation_threshold_(escalation_threshold),
+      acquired_(0),
+      waits_(0),
+      escalations_(0),
+      covered_(0),
+      enable_deadlock_detection_(true) {
+    deadlock_detection_thread_ = new std::thread(&LockManager::RunDeadlockDetection, this);
+}
+
+LockManager::~LockManager() {
+    {
+        std::lock_guard<std::mutex> lock(detection_latch_);
+        enable_deadlock_detection_ = false;
+    }
+    detection_cv_.notify_all();
+    deadlock_detection_thread_->join();
+    delete deadlock_detection_thread_;
+}
+
+bool LockManager::LockTable(Transaction* txn, uint32_t table_oid, LockMode lock_mode) {
+    return Acquire(txn, LockResource::Table(table_oid), lock_mode);
+}
+
+bool LockManager::LockPage(Transaction* txn, uint32_t table_oid, page_id_t page_id, LockMode lock_mode) {
+    auto& held = txn->GetHeldLocks();
+    auto table = held.find(LockResource::Table(table_oid));
+    if (table != held.end() && LockCovers(table->second, lock_mode)) {
+        covered_.fetch_add(1);
+        return true;
+    }
+    if (!Acquire(txn, LockResource::Table(table_oid), IntentionFor(lock_mode))) return false;
+    return Acquire(txn, LockResource::Page(table_oid, page_id), lock_mode);
+}
+
+bool LockManager::LockRow(Transaction* txn, uint32_t table_oid, const RID& rid, LockMode lock_mode) {
+    auto& held = txn->GetHeldLocks();
+    LockResource table = LockResource::Table(table_oid);
+    LockResource page = LockResource::Page(table_oid, rid.GetPageId());
+
+    // Covered by a table lock, e.g. after escalation, or a page lock
+    auto table_it = held.find(table);
+    if (table_it != held.end() && LockCovers(table_it->second, lock_mode)) {
+        covered_.fetch_add(1);
+        return true;
+    }
+    auto page_it = held.find(page);
+    bool page_locked = page_it != held.end();
+    if (page_locked && LockCovers(page_it->second, lock_mode)) {
+        covered_.fetch_add(1);
+        return true;
+    }
+
+    if (!Acquire(txn, table, IntentionFor(lock_mode))) return false;
+    if (page_locked && !Acquire(txn, page, IntentionFor(lock_mode))) return false;
+
+    LockResource row = LockResource::Row(table_oid, rid.GetPageId(), rid.GetSlotNum());
+    bool new_row = held.count(row) == 0;
+    if (!Acquire(txn, row, lock_mode)) return false;
+    if (new_row && ++txn->RowLockCount(table_oid) > escalation_threshold_.load()) {
+        return Escalate(txn, table_oid);
+    }
+    return true;
+}
+
+bool LockManager::Unlock(Transaction* txn, const LockResource& resource) {
+    if (txn->GetHeldLocks().count(resource) == 0) return false;
+    Release(txn, resource);
+    if (txn->GetState() == TransactionState::GROWING) {
+        txn->SetState(TransactionState::SHRINKING);
+    }
+    return true;
+}
+
+void LockManager::UnlockAll(Transaction* txn) {
+    std::vector<LockResource> resources;
+    resources.reserve(txn->GetHeldLocks().size());
+    for (const auto& held : txn->GetHeldLocks()) resources.push_back(held.first);
+    // Rows before pages before tables, the reverse of acquisition
+    std::sort(resources.begin(), resources.end(), [](const LockResource& a, const LockResource& b) {
+        return static_cast<int>(a.granularity) > static_cast<int>(b.granularity);
+    });
+    for (const auto& resource : resources) Release(txn, resource);
+}
+
+LockManager::Stats LockManager::GetStats() const {
+    Stats stats;
+    stats.acquired = acquired_.load();
+    stats.waits = waits_.load();
+    stats.escalations = escalations_.load();
+    stats.covered = covered_.load();
+    return stats;
+}
+
+bool LockManager::GrantLock(LockRequestQueue* queue, txn_id_t txn_id, LockMode lock_mode) {
+    // FIFO: compatible with every granted request and every request
+    // queued ahead; a pending upgrade goes first
+    if (queue->upgrading != -1) return false;
+    for (const auto& request : queue->request_queue) {
+        if (request.txn_id == txn_id) return true;
+        if (!AreLocksCompatible(request.lock_mode, lock_mode)) return false;
+    }
+    return true;
+}
+
+bool LockManager::Acquire(Transaction* txn, const LockResource& resource, LockMode lock_mode) {
+    if (txn->GetState() == TransactionState::ABORTED) return false;
+    if (txn->GetState() == TransactionState::SHRINKING) {
+        txn->SetState(TransactionState::ABORTED);
+        return false;
+    }
+    auto& held = txn->GetHeldLocks();
+    auto held_it = held.find(resource);
+    if (held_it != held.end() && LockCovers(held_it->second, lock_mode)) return true;
+
+    txn_id_t txn_id = txn->GetTransactionId();
+    Partition& partition = GetPartition(resource);
+    std::unique_lock<std::mutex> lock(partition.latch);
+    auto& slot = partition.lock_table[resource];
+    if (!slot) slot = std::make_unique<LockRequestQueue>();
+    LockRequestQueue* queue = slot.get();
+
+    auto request = std::find_if(queue->request_queue.begin(), queue->request_queue.end(),
+                                [txn_id](const LockRequest& r) { return r.txn_id == txn_id; });
+    LockMode granted_mode = lock_mode;
+    bool waited = false;
+
+    if (request != queue->request_queue.end()) {
+        // Upgrade: wait until the combined mode fits next to the other holders
+        if (queue->upgrading != -1) {
+            txn->SetState(TransactionState::ABORTED);
+            return false;
+        }
+        granted_mode = CombineLocks(request->lock_mode, lock_mode);
+        queue->upgrading = txn_id;
+        auto compatible = [&]() {
+            for (const auto& other : queue->request_queue) {
+                if (other.txn_id != txn_id && other.granted &&
+                    !AreLocksCompatible(other.lock_mode, granted_mode)) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        while (!compatible()) {
+            if (txn->GetState() == TransactionState::ABORTED) {
+                queue->upgrading = -1;
+                queue->cv.notify_all();
+                return false;
+            }
+            waited = true;
+            queue->cv.wait(lock);
+        }
+        queue->upgrading = -1;
+        request->lock_mode = granted_mode;
+        queue->cv.notify_all();
+    } else {
+        queue->request_queue.push_back(LockRequest{txn, txn_id, lock_mode, false});
+        request = std::prev(queue->request_queue.end());
+        while (!GrantLock(queue, txn_id, lock_mode)) {
+            if (txn->GetState() == TransactionState::ABORTED) {
+                queue->request_queue.erase(request);
+                if (queue->request_queue.empty()) {
+                    partition.lock_table.erase(resource);
+                } else {
+                    queue->cv.notify_all();
+                }
+                return false;
+            }
+            waited = true;
+            queue->cv.wait(lock);
+        }
+        request->granted = true;
+    }
+    lock.unlock();
+
+    if (waited) waits_.fetch_add(1);
+    acquired_.fetch_add(1);
+    held[resource] = granted_mode;
+    return true;
+}
+
+void LockManager::Release(Transaction* txn, const LockResource& resource) {
+    txn_id_t txn_id = txn->GetTransactionId();
+    {
+        Partition& partition = GetPartition(resource);
+        std::lock_guard<std::mutex> lock(partition.latch);
+        auto it = partition.lock_table.find(resource);
+        if (it != partition.lock_table.end()) {
+            auto& requests = it->second->request_queue;
+            requests.remove_if([txn_id](const LockRequest& r) { return r.txn_id == txn_id; });
+            if (requests.empty()) {
+                partition.lock_table.erase(it);
+            } else {
+                it->second->cv.notify_all();
+            }
+        }
+    }
+    if (txn->GetHeldLocks().erase(resource) != 0 && resource.granularity == LockGranularity::ROW) {
+        size_t& rows = txn->RowLockCount(resource.table_oid);
+        if (rows > 0) --rows;
+    }
+}
+
+bool LockManager::Escalate(Transaction* txn, uint32_t table_oid) {
+    // X if any lock below the table is exclusive, S otherwise
+    bool exclusive = false;
+    std::vector<LockResource> below;
+    for (const auto& held : txn->GetHeldLocks()) {
+        if (held.first.granularity == LockGranularity::TABLE || held.first.table_oid != table_oid) continue;
+        below.push_back(held.first);
+        exclusive |= held.second != LockMode::SHARED && held.second != LockMode::INTENTION_SHARED;
+    }
+    if (!Acquire(txn, LockResource::Table(table_oid),
+                 exclusive ? LockMode::EXCLUSIVE : LockMode::SHARED)) {
+        return false;
+    }
+    for (const auto& resource : below) Release(txn, resource);
+    txn->RowLockCount(table_oid) = 0;
+    escalations_.fetch_add(1);
+    return true;
+}
+
+void LockManager::RunDeadlockDetection() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(detection_latch_);
+            detection_cv_.wait_for(lock, DEADLOCK_DETECTION_INTERVAL,
+                                   [this] { return !enable_deadlock_detection_.load(); });
+            if (!enable_deadlock_detection_) return;
+        }
+
+        // Waits-for edges: a waiting request (or pending upgrade) waits
+        // for every other granted request it conflicts with
+        std::unordered_map<txn_id_t, std::vector<txn_id_t>> wait_graph;
+        std::unordered_map<txn_id_t, Transaction*> waiters;
+        for (auto& partition : partitions_) {
+            std::lock_guard<std::mutex> lock(partition.latch);
+            for (auto& entry : partition.lock_table) {
+                LockRequestQueue* queue = entry.second.get();
+                for (const auto& waiter : queue->request_queue) {
+                    bool upgrading = waiter.txn_id == queue->upgrading;
+                    if (waiter.granted && !upgrading) continue;
+                    waiters[waiter.txn_id] = waiter.txn;
+                    for (const auto& holder : queue->request_queue) {
+                        if (!holder.granted || holder.txn_id == waiter.txn_id) continue;
+                        if (upgrading || !AreLocksCompatible(holder.lock_mode, waiter.lock_mode)) {
+                            wait_graph[waiter.txn_id].push_back(holder.txn_id);
+                        }
+                    }
+                }
+            }
+        }
+        if (wait_graph.empty()) continue;
+
+        std::vector<txn_id_t> txn_ids;
+        for (auto& entry : wait_graph) {
+            std::sort(entry.second.begin(), entry.second.end());
+            txn_ids.push_back(entry.first);
+        }
+        std::sort(txn_ids.begin(), txn_ids.end());
+
+        bool aborted = false;
+        for (txn_id_t txn_id : txn_ids) {
+            txn_id_t victim;
+            while (wait_graph.count(txn_id) != 0 && HasCycle(txn_id, wait_graph, &victim)) {
+                waiters.at(victim)->SetState(TransactionState::ABORTED);
+                wait_graph.erase(victim);
+                aborted = true;
+            }
+        }
+        if (!aborted) continue;
+        for (auto& partition : partitions_) {
+            std::lock_guard<std::mutex> lock(partition.latch);
+            for (auto& entry : partition.lock_table) entry.second->cv.notify_all();
+        }
+    }
+}
+
+bool LockManager::HasCycle(txn_id_t txn_id,
+                           const std::unordered_map<txn_id_t, std::vector<txn_id_t>>& wait_graph,
+                           txn_id_t* victim) {
+    // Iterative DFS; `path` is the current stack of the search
+    std::vector<std::pair<txn_id_t, size_t>> path{{txn_id, 0}};
+    std::unordered_set<txn_id_t> on_path{txn_id};
+    std::unordered_set<txn_id_t> finished;
+    while (!path.empty()) {
+        auto& top = path.back();
+        auto edges = wait_graph.find(top.first);
+        if (edges == wait_graph.end() || top.second == edges->second.size()) {
+            on_path.erase(top.first);
+            finished.insert(top.first);
+            path.pop_back();
+            continue;
+        }
+        txn_id_t next = edges->second[top.second++];
+        if (on_path.count(next) != 0) {
+            *victim = next;
+            for (auto it = path.rbegin(); it != path.rend() && it->first != next; ++it) {
+                *victim = std::max(*victim, it->first);
+            }
+            return true;
+        }
+        if (finished.count(next) == 0) {
+            path.emplace_back(next, 0);
+            on_path.insert(next);
+        }
+    }
+    return false;
+}
+
+} // namespace mokshith
@@ -0,0 +1,27 @@
+#include "transaction/log_manager.h"
+
+namespace mokshith {
+
+size_t LogRecord::GetSize() const {
+    switch (type) {
+        case LogRecordType::INSERT: return sizeof(LogRecord) + insert_size;
+        case LogRecordType::DELETE: return sizeof(LogRecord) + delete_size;
+        case LogRecordType::UPDATE: return sizeof(LogRecord) + old_size + new_size;
+        case LogRecordType::PAGE_WRITE: return sizeof(LogRecord) + 2 * static_cast<size_t>(write_size);
+        default: break;
+    }
+    return sizeof(LogRecord);
+}
+
+void LogRecord::SerializeTo(char* buffer) const {
+    std::memcpy(buffer, reinterpret_cast<const char*>(this), GetSize());
+}
+
+void LogRecord::DeserializeFrom(const char* buffer) {
+    // The fixed part first: it holds the sizes of the rest
+    char* record = reinterpret_cast<char*>(this);
+    std::memcpy(record, buffer, sizeof(LogRecord));
+    std::memcpy(record + sizeof(LogRecord), buffer + sizeof(LogRecord), GetSize() - sizeof(LogRecord));
+}
+
+} // namespace mokshith
@@ -0,0 +1,129 @@
+// Rows/second/core for scan filters: interpreted row-by-row evaluation
+// versus the scalar, SSE4.2 and AVX2 filter kernels.
+//
+//   filter_kernels_benchmark [rows] [iterations]
+#include "execution/filter_kernels.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+
+using namespace mokshith;
+
+namespace {
+
+// Stand-in for the interpreted path: a boxed value and an expression
+// tree walked with a virtual call per node per row
+struct BoxedValue {
+    enum class Type { INTEGER, BOOLEAN } type;
+    int64_t value;
+};
+
+struct Expr {
+    virtual ~Expr() = default;
+    virtual BoxedValue Evaluate(const int32_t* row) const = 0;
+};
+
+struct ColumnExpr : Expr {
+    BoxedValue Evaluate(const int32_t* row) const override {
+        return {BoxedValue::Type::INTEGER, *row};
+    }
+};
+
+struct ConstantExpr : Expr {
+    explicit ConstantExpr(int64_t v) : v_(v) {}
+    BoxedValue Evaluate(const int32_t*) const override {
+        return {BoxedValue::Type::INTEGER, v_};
+    }
+    int64_t v_;
+};
+
+struct CompareExpr : Expr {
+    CompareExpr(CompareOp op, std::unique_ptr<Expr> l, std::unique_ptr<Expr> r)
+        : op_(op), l_(std::move(l)), r_(std::move(r)) {}
+    BoxedValue Evaluate(const int32_t* row) const override {
+        BoxedValue l = l_->Evaluate(row);
+        BoxedValue r = r_->Evaluate(row);
+        return {BoxedValue::Type::BOOLEAN, filter::CompareScalar(l.value, op_, r.value)};
+    }
+    CompareOp op_;
+    std::unique_ptr<Expr> l_, r_;
+};
+
+struct AndExpr : Expr {
+    AndExpr(std::unique_ptr<Expr> l, std::unique_ptr<Expr> r) : l_(std::move(l)), r_(std::move(r)) {}
+    BoxedValue Evaluate(const int32_t* row) const override {
+        return {BoxedValue::Type::BOOLEAN, l_->Evaluate(row).value && r_->Evaluate(row).value};
+    }
+    std::unique_ptr<Expr> l_, r_;
+};
+
+template <typename F>
+double RowsPerSecond(size_t rows, int iterations, F&& body) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) body();
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return rows * static_cast<double>(iterations) / seconds;
+}
+
+const char* LevelName(filter::CpuLevel level) {
+    switch (level) {
+        case filter::CpuLevel::SCALAR: return "scalar";
+        case filter::CpuLevel::SSE42: return "sse4.2";
+        case filter::CpuLevel::AVX2: return "avx2";
+    }
+    return "?";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t rows = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (1 << 20);
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 20;
+    
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int32_t> dist(0, 1000);
+    std::vector<int32_t> data(rows);
+    for (auto& v : data) v = dist(rng);
+    
+    std::vector<uint64_t> mask(filter::MaskWords(rows));
+    std::vector<uint16_t> selection(filter::MaskWords(rows) * 64);
+    volatile size_t sink = 0;
+    
+    // Predicate: x >= 250 AND x < 750, chunked like NextBatch
+    auto predicate = std::make_unique<AndExpr>(
+        std::make_unique<CompareExpr>(CompareOp::GE, std::make_unique<ColumnExpr>(),
+                                      std::make_unique<ConstantExpr>(250)),
+        std::make_unique<CompareExpr>(CompareOp::LT, std::make_unique<ColumnExpr>(),
+                                      std::make_unique<ConstantExpr>(750)));
+    
+    double interpreted = RowsPerSecond(rows, iterations, [&]() {
+        size_t n = 0;
+        for (size_t i = 0; i < rows; ++i) n += predicate->Evaluate(&data[i]).value != 0;
+        sink = n;
+    });
+    std::printf("%-12s %10.1f Mrows/s\n", "interpreted", interpreted / 1e6);
+    
+    const size_t chunk = 1024;
+    std::vector<uint64_t> upper(filter::MaskWords(chunk));
+    for (auto level : {filter::CpuLevel::SCALAR, filter::CpuLevel::SSE42, filter::CpuLevel::AVX2}) {
+        if (level > filter::DetectCpuLevel()) continue;
+        filter::SetCpuLevel(level);
+        double rate = RowsPerSecond(rows, iterations, [&]() {
+            size_t n = 0;
+            for (size_t base = 0; base < rows; base += chunk) {
+                size_t count = std::min(chunk, rows - base);
+                filter::CompareConstant(&data[base], count, CompareOp::GE, 250, mask.data());
+                filter::CompareConstant(&data[base], count, CompareOp::LT, 750, upper.data());
+                filter::MaskAnd(mask.data(), upper.data(), count);
+                n += filter::MaskToSelection(mask.data(), count, selection.data());
+            }
+            sink = n;
+        });
+        std::printf("%-12s %10.1f Mrows/s  (%.1fx)\n", LevelName(level), rate / 1e6, rate / interpreted);
+    }
+    (void)sink;
+    return 0;
+}
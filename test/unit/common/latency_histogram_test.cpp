@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include "common/latency_histogram.h"
+#include <thread>
+#include <vector>
+
+using namespace mokshith;
+
+TEST(LatencyHistogramTest, PercentilesWithinBucketError) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.Percentile(50), 0u);
+    
+    for (uint64_t micros = 1; micros <= 10000; ++micros) histogram.Record(micros);
+    EXPECT_EQ(histogram.Count(), 10000u);
+    EXPECT_EQ(histogram.Max(), 10000u);
+    EXPECT_NEAR(histogram.Mean(), 5000.5, 0.01);
+    
+    // Log-linear buckets: at most 1/16 relative error
+    for (double p : {50.0, 90.0, 95.0, 99.0, 99.9}) {
+        double exact = p / 100.0 * 10000;
+        uint64_t estimate = histogram.Percentile(p);
+        EXPECT_GE(estimate, exact - 1) << p;
+        EXPECT_LE(estimate, exact * (1 + 1.0 / 16) + 1) << p;
+    }
+    EXPECT_EQ(histogram.Percentile(100), 10000u);
+    
+    histogram.Reset();
+    EXPECT_EQ(histogram.Count(), 0u);
+}
+
+TEST(LatencyHistogramTest, SmallAndHugeValues) {
+    LatencyHistogram histogram;
+    for (int i = 0; i < 99; ++i) histogram.Record(3);
+    histogram.Record(uint64_t(1) << 40);
+    EXPECT_EQ(histogram.Percentile(50), 3u);
+    EXPECT_EQ(histogram.Percentile(99), 3u);
+    EXPECT_EQ(histogram.Percentile(100), uint64_t(1) << 40);
+}
+
+TEST(LatencyHistogramTest, ConcurrentRecords) {
+    LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 10000; ++i) histogram.Record(100);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    EXPECT_EQ(histogram.Count(), 80000u);
+    EXPECT_EQ(histogram.Max(), 100u);
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "common/optimistic_latch.h"
+#include "storage/page.h"
+#include <thread>
+#include <vector>
+
+using namespace mokshith;
+
+TEST(OptimisticLatchTest, WriteInvalidatesReaders) {
+    OptimisticLatch latch;
+    bool restart = false;
+    uint64_t version = latch.ReadLockOrRestart(restart);
+    ASSERT_FALSE(restart);
+    
+    latch.CheckOrRestart(version, restart);
+    EXPECT_FALSE(restart);
+    
+    latch.WriteLockOrRestart(restart);
+    ASSERT_FALSE(restart);
+    EXPECT_TRUE(latch.IsLocked());
+    latch.WriteUnlock();
+    EXPECT_FALSE(latch.IsLocked());
+    
+    latch.CheckOrRestart(version, restart);
+    EXPECT_TRUE(restart);
+}
+
+TEST(OptimisticLatchTest, UpgradeFailsAfterConcurrentWrite) {
+    OptimisticLatch latch;
+    bool restart = false;
+    uint64_t stale = latch.ReadLockOrRestart(restart);
+    uint64_t fresh = stale;
+    latch.UpgradeToWriteLockOrRestart(fresh, restart);
+    ASSERT_FALSE(restart);
+    latch.WriteUnlock();
+    
+    latch.UpgradeToWriteLockOrRestart(stale, restart);
+    EXPECT_TRUE(restart);
+    EXPECT_FALSE(latch.IsLocked());
+}
+
+TEST(OptimisticLatchTest, ObsoleteNodesForceRestart) {
+    OptimisticLatch latch;
+    bool restart = false;
+    latch.WriteLockOrRestart(restart);
+    latch.WriteUnlockObsolete();
+    EXPECT_FALSE(latch.IsLocked());
+    
+    latch.ReadLockOrRestart(restart);
+    EXPECT_TRUE(restart);
+}
+
+// Writers keep two counters equal under the latch; optimistic readers
+// must never validate a torn pair
+TEST(OptimisticLatchTest, ConcurrentReadersSeeConsistentState) {
+    OptimisticLatch latch;
+    std::atomic<int64_t> a{0}, b{0};
+    std::atomic<bool> stop{false};
+    std::atomic<int> torn{0};
+    std::atomic<int64_t> validated{0};
+    
+    std::vector<std::thread> threads;
+    for (int w = 0; w < 2; ++w) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 20000; ++i) {
+                bool restart = false;
+                latch.WriteLockOrRestart(restart);
+                if (restart) continue;
+                a.fetch_add(1, std::memory_order_relaxed);
+                b.fetch_add(1, std::memory_order_relaxed);
+                latch.WriteUnlock();
+            }
+        });
+    }
+    for (int r = 0; r < 4; ++r) {
+        threads.emplace_back([&]() {
+            while (!stop.load()) {
+                bool restart = false;
+                uint64_t version = latch.ReadLockOrRestart(restart);
+                int64_t x = a.load(std::memory_order_relaxed);
+                int64_t y = b.load(std::memory_order_relaxed);
+                latch.CheckOrRestart(version, restart);
+                if (restart) continue;
+                ++validated;
+                if (x != y) ++torn;
+            }
+        });
+    }
+    threads[0].join();
+    threads[1].join();
+    stop = true;
+    for (size_t i = 2; i < threads.size(); ++i) threads[i].join();
+    
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_GT(validated.load(), 0);
+    EXPECT_EQ(a.load(), b.load());
+}
+
+TEST(OptimisticLatchTest, ResetClearsObsolete) {
+    OptimisticLatch latch;
+    bool restart = false;
+    latch.WriteLockOrRestart(restart);
+    ASSERT_FALSE(restart);
+    latch.WriteUnlockObsolete();
+    
+    uint64_t stale = latch.ReadLockOrRestart(restart);
+    EXPECT_TRUE(restart);
+    
+    latch.Reset();
+    restart = false;
+    latch.ReadLockOrRestart(restart);
+    EXPECT_FALSE(restart);
+    // Readers of the old node still fail validation
+    latch.CheckOrRestart(stale, restart);
+    EXPECT_TRUE(restart);
+}
+
+TEST(OptimisticLatchTest, ReusedFrameIsNotObsolete) {
+    // A B+Tree node merged away, then its frame handed to another page
+    Page page;
+    page.Init(1);
+    bool restart = false;
+    page.GetLatch().WriteLockOrRestart(restart);
+    ASSERT_FALSE(restart);
+    page.GetLatch().WriteUnlockObsolete();
+    
+    page.Init(2);
+    page.GetLatch().ReadLockOrRestart(restart);
+    EXPECT_FALSE(restart);
+    page.GetLatch().WriteLockOrRestart(restart);
+    EXPECT_FALSE(restart);
+    page.GetLatch().WriteUnlock();
+    EXPECT_EQ(page.GetPageId(), 2);
+}
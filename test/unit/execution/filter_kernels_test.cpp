@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include "execution/filter_kernels.h"
+#include <random>
+
+using namespace mokshith;
+
+class FilterKernelsTest : public ::testing::TestWithParam<filter::CpuLevel> {
+protected:
+    void SetUp() override { filter::SetCpuLevel(GetParam()); }
+    void TearDown() override { filter::SetCpuLevel(filter::CpuLevel::AVX2); }
+    
+    template <typename T>
+    static std::vector<uint64_t> Reference(const std::vector<T>& data, CompareOp op, T c) {
+        std::vector<uint64_t> mask(filter::MaskWords(data.size()), 0);
+        filter::CompareConstantScalar(data.data(), 0, data.size(), op, c, mask.data());
+        return mask;
+    }
+};
+
+static const CompareOp kOps[] = {CompareOp::EQ, CompareOp::NE, CompareOp::LT,
+                                 CompareOp::LE, CompareOp::GT, CompareOp::GE};
+
+TEST_P(FilterKernelsTest, Int32MatchesScalar) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int32_t> dist(-50, 50);
+    std::vector<int32_t> data(1021);  // odd size exercises the scalar tail
+    for (auto& v : data) v = dist(rng);
+    
+    std::vector<uint64_t> mask(filter::MaskWords(data.size()));
+    for (auto op : kOps) {
+        filter::CompareConstant(data.data(), data.size(), op, 3, mask.data());
+        EXPECT_EQ(mask, Reference(data, op, 3));
+    }
+}
+
+TEST_P(FilterKernelsTest, Int64MatchesScalar) {
+    std::vector<int64_t> data;
+    for (int64_t i = -500; i < 523; ++i) data.push_back(i * 1000003);
+    
+    std::vector<uint64_t> mask(filter::MaskWords(data.size()));
+    for (auto op : kOps) {
+        filter::CompareConstant(data.data(), data.size(), op, int64_t(7000021), mask.data());
+        EXPECT_EQ(mask, Reference(data, op, int64_t(7000021)));
+    }
+}
+
+TEST_P(FilterKernelsTest, FloatMatchesScalar) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> data(999);
+    for (auto& v : data) v = dist(rng);
+    data[10] = 0.25f;
+    
+    std::vector<uint64_t> mask(filter::MaskWords(data.size()));
+    for (auto op : kOps) {
+        filter::CompareConstant(data.data(), data.size(), op, 0.25f, mask.data());
+        EXPECT_EQ(mask, Reference(data, op, 0.25f));
+    }
+}
+
+TEST_P(FilterKernelsTest, BoolMatchesScalar) {
+    std::vector<uint8_t> data(130);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = (i % 3) == 0;
+    
+    std::vector<uint64_t> mask(filter::MaskWords(data.size()));
+    for (auto op : kOps) {
+        for (uint8_t c : {uint8_t(0), uint8_t(1)}) {
+            filter::CompareConstant(data.data(), data.size(), op, c, mask.data());
+            EXPECT_EQ(mask, Reference(data, op, c)) << static_cast<int>(op) << " " << int(c);
+        }
+    }
+}
+
+// Ordered ops compare bytes unsigned on every CPU level
+TEST_P(FilterKernelsTest, ByteOrderedOpsMatchScalar) {
+    std::vector<uint8_t> zeros(96, 0);
+    std::vector<uint64_t> mask(filter::MaskWords(zeros.size()));
+    filter::CompareConstant(zeros.data(), zeros.size(), CompareOp::LT, uint8_t(1), mask.data());
+    EXPECT_EQ(mask, Reference(zeros, CompareOp::LT, uint8_t(1)));
+    EXPECT_EQ(mask[0], ~uint64_t(0));
+    
+    std::vector<uint8_t> data(257);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<uint8_t>(i * 37);
+    mask.assign(filter::MaskWords(data.size()), 0);
+    for (auto op : kOps) {
+        for (uint8_t c : {uint8_t(0), uint8_t(100), uint8_t(128), uint8_t(200), uint8_t(255)}) {
+            filter::CompareConstant(data.data(), data.size(), op, c, mask.data());
+            EXPECT_EQ(mask, Reference(data, op, c)) << static_cast<int>(op) << " " << int(c);
+        }
+    }
+}
+
+TEST_P(FilterKernelsTest, BetweenInListAndSelection) {
+    std::vector<int32_t> data;
+    for (int32_t i = 0; i < 200; ++i) data.push_back(i);
+    std::vector<uint64_t> mask(filter::MaskWords(data.size()));
+    std::vector<uint16_t> selection(data.size());
+    
+    filter::Between(data.data(), data.size(), 10, 19, mask.data());
+    ASSERT_EQ(filter::MaskToSelection(mask.data(), data.size(), selection.data()), 10u);
+    EXPECT_EQ(selection[0], 10);
+    EXPECT_EQ(selection[9], 19);
+    
+    filter::InList(data.data(), data.size(), std::vector<int32_t>{5, 150, 999}, mask.data());
+    ASSERT_EQ(filter::MaskToSelection(mask.data(), data.size(), selection.data()), 2u);
+    EXPECT_EQ(selection[1], 150);
+    
+    std::vector<int32_t> long_list;
+    for (int32_t i = 0; i < 40; ++i) long_list.push_back(i * 5);
+    filter::InList(data.data(), data.size(), long_list, mask.data());
+    filter::MaskNot(mask.data(), data.size());
+    EXPECT_EQ(filter::MaskToSelection(mask.data(), data.size(), selection.data()), 160u);
+}
+
+INSTANTIATE_TEST_SUITE_P(CpuLevels, FilterKernelsTest,
+                         ::testing::Values(filter::CpuLevel::SCALAR,
+                                           filter::CpuLevel::SSE42,
+                                           filter::CpuLevel::AVX2));
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include "execution/join_hash_table.h"
+#include <unordered_map>
+
+using namespace mokshith;
+
+TEST(JoinHashTableTest, DuplicatesAndGrowth) {
+    JoinHashTable table(4);
+    // Poor hash on purpose: many keys share a hash and collide
+    for (uint32_t row = 0; row < 1000; ++row) table.Insert(row % 100, row);
+    EXPECT_EQ(table.Size(), 1000u);
+    EXPECT_GE(table.Capacity(), 2000u);
+    
+    std::vector<uint32_t> matches;
+    table.Probe(42, [&](uint32_t row) {
+        matches.push_back(row);
+        return true;
+    });
+    ASSERT_EQ(matches.size(), 10u);
+    for (uint32_t row : matches) EXPECT_EQ(row % 100, 42u);
+    
+    size_t visited = 0;
+    table.Probe(42, [&](uint32_t) { return ++visited < 3; });
+    EXPECT_EQ(visited, 3u);
+    
+    bool found = false;
+    table.Probe(12345, [&](uint32_t) { return found = true; });
+    EXPECT_FALSE(found);
+}
+
+TEST(JoinHashTableTest, ZeroHashIsStored) {
+    JoinHashTable table;
+    table.Insert(0, 7);
+    std::vector<uint32_t> rows;
+    table.Probe(0, [&](uint32_t row) {
+        rows.push_back(row);
+        return true;
+    });
+    ASSERT_EQ(rows.size(), 1u);
+    EXPECT_EQ(rows[0], 7u);
+}
+
+TEST(JoinHashTableTest, RadixPartitionsFitInCache) {
+    EXPECT_EQ(RadixPartitioner::ChooseBits(1024, 16), 0u);
+    uint32_t bits = RadixPartitioner::ChooseBits(64 * 1024 * 1024, 1 << 20);
+    EXPECT_GT(bits, 0u);
+    EXPECT_LE(bits, MAX_RADIX_BITS);
+    
+    RadixPartitioner partitioner(bits);
+    EXPECT_EQ(partitioner.GetPartition(~uint64_t(0)), partitioner.GetNumPartitions() - 1);
+    EXPECT_EQ(partitioner.GetPartition(12345), 0u);
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include "execution/sort_util.h"
+#include <random>
+
+using namespace mokshith;
+
+namespace {
+
+std::string IntKey(int32_t value, bool descending = false) {
+    std::string key(KeyNormalizer::EncodedSize(sizeof(int32_t)), '\0');
+    KeyNormalizer::EncodeInt32(value, descending, &key[0]);
+    return key;
+}
+
+std::string FloatKey(float value, bool descending = false) {
+    std::string key(KeyNormalizer::EncodedSize(sizeof(float)), '\0');
+    KeyNormalizer::EncodeFloat(value, descending, &key[0]);
+    return key;
+}
+
+} // namespace
+
+TEST(SortUtilTest, NormalizedIntegersCompareWithMemcmp) {
+    std::vector<int32_t> values = {INT32_MIN, -1000, -1, 0, 1, 7, 1000, INT32_MAX};
+    for (size_t i = 0; i + 1 < values.size(); ++i) {
+        EXPECT_LT(IntKey(values[i]), IntKey(values[i + 1]));
+        EXPECT_GT(IntKey(values[i], true), IntKey(values[i + 1], true));
+    }
+
+    std::string null_first(KeyNormalizer::EncodedSize(sizeof(int32_t)), '\0');
+    std::string null_last(KeyNormalizer::EncodedSize(sizeof(int32_t)), '\0');
+    KeyNormalizer::EncodeNull(sizeof(int32_t), true, &null_first[0]);
+    KeyNormalizer::EncodeNull(sizeof(int32_t), false, &null_last[0]);
+    EXPECT_LT(null_first, IntKey(INT32_MIN));
+    EXPECT_LT(null_first, IntKey(INT32_MIN, true));
+    EXPECT_GT(null_last, IntKey(INT32_MAX));
+    EXPECT_GT(null_last, IntKey(INT32_MIN, true));
+}
+
+TEST(SortUtilTest, NormalizedFloatsCompareWithMemcmp) {
+    std::vector<float> values = {-1e30f, -2.5f, -1e-10f, 0.0f, 1e-10f, 0.5f, 3.0f, 1e30f};
+    for (size_t i = 0; i + 1 < values.size(); ++i) {
+        EXPECT_LT(FloatKey(values[i]), FloatKey(values[i + 1]));
+        EXPECT_GT(FloatKey(values[i], true), FloatKey(values[i + 1], true));
+    }
+    EXPECT_EQ(FloatKey(-0.0f), FloatKey(0.0f));
+}
+
+TEST(SortUtilTest, NormalizedStringsUsePaddedPrefix) {
+    const uint32_t prefix = 4;
+    auto key = [&](const std::string& s, bool* truncated) {
+        std::string out(KeyNormalizer::EncodedSize(prefix), '\0');
+        *truncated = KeyNormalizer::EncodeString(s.data(), s.size(), prefix, false, &out[0]);
+        return out;
+    };
+    bool truncated;
+    EXPECT_LT(key("", &truncated), key("a", &truncated));
+    EXPECT_LT(key("a", &truncated), key("ab", &truncated));
+    EXPECT_LT(key("ab", &truncated), key("b", &truncated));
+    EXPECT_FALSE(truncated);
+
+    std::string long_a = key("abcdx", &truncated);
+    EXPECT_TRUE(truncated);
+    EXPECT_EQ(long_a, key("abcdy", &truncated));
+}
+
+TEST(SortUtilTest, LoserTreeMergesRuns) {
+    std::mt19937 rng(42);
+    for (size_t k : {1, 2, 3, 5, 8, 13}) {
+        std::vector<std::vector<int>> runs(k);
+        std::vector<int> expected;
+        for (auto& run : runs) {
+            size_t length = rng() % 50;  // some runs are empty
+            for (size_t i = 0; i < length; ++i) run.push_back(static_cast<int>(rng() % 100));
+            std::sort(run.begin(), run.end());
+            expected.insert(expected.end(), run.begin(), run.end());
+        }
+        std::sort(expected.begin(), expected.end());
+
+        std::vector<size_t> positions(k, 0);
+        auto less = [&](size_t a, size_t b) {
+            return runs[a][positions[a]] < runs[b][positions[b]];
+        };
+        LoserTree<decltype(less)> tree(k, less);
+        for (size_t i = 0; i < k; ++i) {
+            if (runs[i].empty()) tree.MarkExhausted(i);
+        }
+        tree.Build();
+
+        std::vector<int> merged;
+        while (!tree.Empty()) {
+            size_t winner = tree.Winner();
+            merged.push_back(runs[winner][positions[winner]]);
+            if (++positions[winner] == runs[winner].size()) tree.MarkExhausted(winner);
+            tree.Replay();
+        }
+        EXPECT_EQ(merged, expected) << "k = " << k;
+    }
+}
+
+TEST(SortUtilTest, TopNKeepsSmallestKeys) {
+    const size_t limit = 10;
+    TopNHeap heap(limit, KeyNormalizer::EncodedSize(sizeof(int32_t)));
+    std::mt19937 rng(7);
+    std::vector<int32_t> values;
+    for (int i = 0; i < 10000; ++i) {
+        int32_t value = static_cast<int32_t>(rng() % 100000) - 50000;
+        values.push_back(value);
+        std::string key = IntKey(value);
+        std::string row = std::to_string(value);
+        heap.Push(key.data(), row.data(), row.size());
+        EXPECT_LE(heap.Size(), limit);
+    }
+    std::sort(values.begin(), values.end());
+
+    std::vector<size_t> sorted = heap.TakeSorted();
+    ASSERT_EQ(sorted.size(), limit);
+    for (size_t i = 0; i < limit; ++i) {
+        EXPECT_EQ(heap.GetRow(sorted[i]), std::to_string(values[i]));
+    }
+
+    TopNHeap empty(0, 4);
+    EXPECT_FALSE(empty.Accepts("abcd"));
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include "index/btree_node.h"
+#include <map>
+#include <random>
+
+using namespace mokshith;
+
+namespace {
+
+bool InsertKey(VarKeyNode& node, const std::string& key, int32_t value) {
+    return node.Insert(key.data(), static_cast<uint16_t>(key.size()),
+                       reinterpret_cast<const char*>(&value));
+}
+
+int32_t GetValue(const VarKeyNode& node, uint16_t pos) {
+    int32_t value;
+    std::memcpy(&value, node.GetValue(pos), sizeof(value));
+    return value;
+}
+
+} // namespace
+
+TEST(VarKeyNodeTest, PrefixTruncatedKeysStaySorted) {
+    alignas(8) char page[PAGE_SIZE];
+    VarKeyNode node(page);
+    std::string prefix = "customer/";
+    node.Init(prefix.data(), static_cast<uint16_t>(prefix.size()), sizeof(int32_t), true);
+    
+    std::mt19937 rng(3);
+    std::map<std::string, int32_t> expected;
+    for (int i = 0; i < 150; ++i) {
+        // Many keys share their first 4 suffix bytes to exercise head ties
+        std::string key = prefix + "id" + std::to_string(rng() % 100000);
+        if (expected.count(key)) continue;
+        ASSERT_TRUE(InsertKey(node, key, i));
+        expected[key] = i;
+    }
+    ASSERT_EQ(node.GetCount(), expected.size());
+    
+    uint16_t pos = 0;
+    for (const auto& entry : expected) {
+        EXPECT_EQ(node.GetKey(pos), entry.first);
+        EXPECT_EQ(GetValue(node, pos), entry.second);
+        ++pos;
+    }
+    
+    for (const auto& entry : expected) {
+        bool found;
+        uint16_t at = node.LowerBound(entry.first.data(), static_cast<uint16_t>(entry.first.size()), &found);
+        EXPECT_TRUE(found);
+        EXPECT_EQ(node.GetKey(at), entry.first);
+        
+        std::string missing = entry.first + "~";
+        at = node.LowerBound(missing.data(), static_cast<uint16_t>(missing.size()), &found);
+        EXPECT_FALSE(found);
+        auto next = expected.upper_bound(missing);
+        EXPECT_EQ(at, static_cast<uint16_t>(std::distance(expected.begin(), next)));
+    }
+    
+    bool found;
+    std::string before = "a";
+    std::string after = "z";
+    EXPECT_EQ(node.LowerBound(before.data(), 1, &found), 0);
+    EXPECT_EQ(node.LowerBound(after.data(), 1, &found), node.GetCount());
+    EXPECT_EQ(node.LowerBound(prefix.data(), static_cast<uint16_t>(prefix.size()), &found), 0);
+}
+
+TEST(VarKeyNodeTest, RemoveAndCompactReclaimSpace) {
+    alignas(8) char page[PAGE_SIZE];
+    VarKeyNode node(page);
+    node.Init("", 0, sizeof(int32_t), true);
+    
+    std::string filler(100, 'x');
+    int inserted = 0;
+    while (InsertKey(node, filler + std::to_string(1000 + inserted), inserted)) ++inserted;
+    EXPECT_GT(inserted, 20);
+    size_t full_free = node.GetFreeSpace();
+    
+    // Drop every other key
+    for (uint16_t pos = 0; pos < node.GetCount(); ++pos) node.Remove(pos);
+    EXPECT_GT(node.GetFreeSpace(), full_free);
+    
+    // Inserting again needs the holes back
+    int reinserted = 0;
+    while (node.GetCount() < inserted &&
+           InsertKey(node, filler + std::to_string(5000 + reinserted), reinserted)) {
+        ++reinserted;
+    }
+    EXPECT_EQ(node.GetCount(), static_cast<uint16_t>(inserted));
+    for (uint16_t pos = 1; pos < node.GetCount(); ++pos) {
+        EXPECT_LT(node.GetKey(pos - 1), node.GetKey(pos));
+    }
+}
+
+TEST(VarKeyNodeTest, SeparatorsAreShortest) {
+    std::string left = "apple";
+    std::string right = "apricot";
+    uint16_t length = VarKeyNode::SeparatorLength(left.data(), 5, right.data(), 7);
+    EXPECT_EQ(right.substr(0, length), "apr");
+    EXPECT_GT(right.substr(0, length), left);
+    
+    EXPECT_EQ(VarKeyNode::CommonPrefixLength("abc", 3, "abd", 3), 2);
+    EXPECT_LT(VarKeyNode::MakeHead("ab", 2), VarKeyNode::MakeHead("abc", 3));
+    EXPECT_LT(VarKeyNode::MakeHead("\x7f", 1), VarKeyNode::MakeHead("\x80", 1));
+}
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include "index/hash_index.h"
+#include <cstdio>
+#include <functional>
+#include <memory>
+
+using namespace mokshith;
+
+namespace {
+
+using IntBucket = HashBucketPage<int, int>;
+
+std::unique_ptr<char[]> NewPageBuffer() {
+    std::unique_ptr<char[]> buffer(new char[PAGE_SIZE]);
+    std::memset(buffer.get(), 0, PAGE_SIZE);
+    return buffer;
+}
+
+} // namespace
+
+TEST(HashBucketPageTest, InsertLookupRemove) {
+    auto buffer = NewPageBuffer();
+    auto* bucket = reinterpret_cast<IntBucket*>(buffer.get());
+    bucket->Init();
+    static_assert(sizeof(IntBucket) <= PAGE_SIZE, "bucket must fit in a page");
+    
+    // Identity hash: the bucket mixes it before probing
+    int inserted = 0;
+    while (bucket->Insert(inserted, inserted, inserted * 10) == BucketInsertResult::INSERTED) {
+        ++inserted;
+    }
+    EXPECT_TRUE(bucket->IsFull());
+    EXPECT_EQ(static_cast<size_t>(inserted), IntBucket::MAX_LOAD);
+    
+    for (int key = 0; key < inserted; ++key) {
+        std::vector<int> result;
+        bucket->GetValue(key, key, result);
+        ASSERT_EQ(result.size(), 1u) << key;
+        EXPECT_EQ(result[0], key * 10);
+    }
+    
+    EXPECT_FALSE(bucket->Remove(3, 3, 999));
+    EXPECT_TRUE(bucket->Remove(3, 3, 30));
+    std::vector<int> result;
+    bucket->GetValue(3, 3, result);
+    EXPECT_TRUE(result.empty());
+    
+    // The tombstone is reused
+    EXPECT_EQ(bucket->Insert(3, 3, 31), BucketInsertResult::INSERTED);
+    EXPECT_EQ(bucket->Insert(inserted, inserted, 0), BucketInsertResult::FULL);
+    // A duplicate in a full bucket is not mistaken for "full"
+    EXPECT_EQ(bucket->Insert(0, 0, 0), BucketInsertResult::DUPLICATE);
+    bucket->GetValue(3, 3, result);
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0], 31);
+}
+
+TEST(HashBucketPageTest, DuplicateKeys) {
+    auto buffer = NewPageBuffer();
+    auto* bucket = reinterpret_cast<IntBucket*>(buffer.get());
+    bucket->Init();
+    
+    EXPECT_EQ(bucket->Insert(7, 7, 1), BucketInsertResult::INSERTED);
+    EXPECT_EQ(bucket->Insert(7, 7, 2), BucketInsertResult::INSERTED);
+    EXPECT_EQ(bucket->Insert(7, 7, 2), BucketInsertResult::DUPLICATE);
+    std::vector<int> result;
+    bucket->GetValue(7, 7, result);
+    EXPECT_EQ(result.size(), 2u);
+    
+    EXPECT_EQ(bucket->RemoveAll(7, 7), 2u);
+    EXPECT_TRUE(bucket->IsEmpty());
+}
+
+TEST(HashDirectoryPageTest, GrowSplitAndShrink) {
+    auto buffer = NewPageBuffer();
+    auto* directory = reinterpret_cast<HashDirectoryPage*>(buffer.get());
+    directory->Init(100);
+    EXPECT_EQ(directory->Size(), 1u);
+    
+    // Split bucket 0 (depth 0 -> 1)
+    ASSERT_TRUE(directory->Grow());
+    directory->SetBucket(0, 1, 100);
+    directory->SetBucket(1, 1, 101);
+    EXPECT_EQ(directory->GetBucketPageId(directory->GetIndex(6)), 100);
+    EXPECT_EQ(directory->GetBucketPageId(directory->GetIndex(7)), 101);
+    EXPECT_EQ(directory->GetSplitImageIndex(0), 1u);
+    
+    // Split bucket 1 only (depth 1 -> 2); bucket 0 stays shared
+    ASSERT_TRUE(directory->Grow());
+    directory->SetBucket(1, 2, 101);
+    directory->SetBucket(3, 2, 103);
+    EXPECT_EQ(directory->GetBucketPageId(0), 100);
+    EXPECT_EQ(directory->GetBucketPageId(2), 100);
+    EXPECT_EQ(directory->GetLocalDepth(2), 1u);
+    EXPECT_EQ(directory->GetBucketPageId(directory->GetIndex(7)), 103);
+    EXPECT_FALSE(directory->CanShrink());
+    
+    // Merge 3 back into 1
+    directory->SetBucket(1, 1, 101);
+    EXPECT_TRUE(directory->CanShrink());
+    directory->Shrink();
+    EXPECT_EQ(directory->GetGlobalDepth(), 1u);
+    EXPECT_EQ(directory->GetBucketPageId(1), 101);
+    
+    while (directory->Grow()) {}
+    EXPECT_EQ(directory->GetGlobalDepth(), HashDirectoryPage::MAX_DEPTH);
+}
+
+class HashIndexTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        disk_manager_ = new DiskManager("hash_index_test.db");
+        // Fewer frames than bucket pages, so buckets are evicted and reread
+        buffer_pool_ = new BufferPool(256, disk_manager_);
+    }
+    
+    void TearDown() override {
+        delete buffer_pool_;
+        delete disk_manager_;
+        std::remove("hash_index_test.db");
+    }
+    
+    DiskManager* disk_manager_;
+    BufferPool* buffer_pool_;
+};
+
+TEST_F(HashIndexTest, GrowsPastOneDirectoryPage) {
+    using IntIndex = HashIndex<int, int, std::hash<int>>;
+    IntIndex index(buffer_pool_, std::hash<int>());
+    
+    // More entries than 512 full buckets hold
+    const int num_keys = static_cast<int>(HashDirectoryPage::MAX_SIZE * IntBucket::MAX_LOAD) + 10000;
+    for (int key = 0; key < num_keys; ++key) {
+        ASSERT_TRUE(index.Insert(key, key * 2, 0)) << key;
+    }
+    EXPECT_FALSE(index.Insert(7, 14, 0));
+    EXPECT_GT(index.GetGlobalDepth(), HashDirectoryPage::MAX_DEPTH);
+    
+    // Reopened from the root page
+    IntIndex reopened(buffer_pool_, std::hash<int>(), index.GetDirectoryPageId());
+    for (int key = 0; key < num_keys; ++key) {
+        std::vector<int> result;
+        ASSERT_TRUE(reopened.GetValue(key, result)) << key;
+        ASSERT_EQ(result.size(), 1u);
+        EXPECT_EQ(result[0], key * 2);
+    }
+    
+    for (int key = 0; key < num_keys; key += 2) {
+        ASSERT_TRUE(reopened.Remove(key, 0)) << key;
+    }
+    for (int key = 0; key < 1000; ++key) {
+        std::vector<int> result;
+        EXPECT_EQ(reopened.GetValue(key, result), key % 2 == 1) << key;
+    }
+}
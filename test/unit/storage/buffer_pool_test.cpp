@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include "storage/buffer_pool.h"
 #include "storage/disk_manager.h"
+#include <thread>
 
 using namespace mokshith;
 
@@ -36,12 +37,13 @@ TEST_F(BufferPoolTest, FetchExistingPage) {
     Page* page1 = buffer_pool_->NewPage(page_id);
     ASSERT_NE(page1, nullptr);
     
-    strcpy(page1->GetData(), "Test Data");
+    // Payload after the PageHeader, which holds the page LSN
+    strcpy(page1->GetData() + PAGE_HEADER_SIZE, "Test Data");
     buffer_pool_->UnpinPage(page_id, true);
     
     Page* page2 = buffer_pool_->FetchPage(page_id);
     ASSERT_NE(page2, nullptr);
-    EXPECT_STREQ(page2->GetData(), "Test Data");
+    EXPECT_STREQ(page2->GetData() + PAGE_HEADER_SIZE, "Test Data");
     
     buffer_pool_->UnpinPage(page_id, false);
 }
@@ -66,4 +68,43 @@ TEST_F(BufferPoolTest, LRUEviction) {
     // First page should no longer be in buffer pool
     Page* evicted_page = buffer_pool_->FetchPage(page_ids[0]);
     ASSERT_NE(evicted_page, nullptr);  // But can still fetch from disk
-}
\ No newline at end of file
+}
+
+TEST(ShardedBufferPoolTest, ConcurrentFetchAcrossShards) {
+    DiskManager disk_manager("sharded_test.db");
+    BufferPool buffer_pool(256, &disk_manager, 8);
+    ASSERT_EQ(buffer_pool.GetNumShards(), 8u);
+    
+    std::vector<page_id_t> page_ids;
+    for (size_t i = 0; i < 64; ++i) {
+        page_id_t page_id;
+        Page* page = buffer_pool.NewPage(page_id);
+        ASSERT_NE(page, nullptr);
+        snprintf(page->GetData() + PAGE_HEADER_SIZE, PAGE_SIZE - PAGE_HEADER_SIZE, "page %d", page_id);
+        page_ids.push_back(page_id);
+        buffer_pool.UnpinPage(page_id, true);
+    }
+    
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 16; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int round = 0; round < 1000; ++round) {
+                page_id_t page_id = page_ids[(t * 7 + round) % page_ids.size()];
+                Page* page = buffer_pool.FetchPage(page_id);
+                if (page == nullptr) {
+                    ++mismatches;
+                    continue;
+                }
+                char expected[32];
+                snprintf(expected, sizeof(expected), "page %d", page_id);
+                if (strcmp(page->GetData() + PAGE_HEADER_SIZE, expected) != 0) ++mismatches;
+                buffer_pool.UnpinPage(page_id, false);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    
+    EXPECT_EQ(mismatches.load(), 0);
+    std::remove("sharded_test.db");
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include "storage/compression.h"
+#include <random>
+
+using namespace mokshith;
+
+TEST(CompressionTest, BitPackRoundTrip) {
+    std::vector<uint32_t> values;
+    for (uint32_t i = 0; i < 1000; ++i) values.push_back((i * 37) % 1000);
+    
+    uint32_t bits = BitPacker::BitsRequired(999);
+    EXPECT_EQ(bits, 10u);
+    std::vector<uint8_t> packed(BitPacker::PackedSize(values.size(), bits) + 8);
+    BitPacker::Pack(values.data(), values.size(), bits, packed.data());
+    
+    std::vector<uint32_t> unpacked(values.size());
+    BitPacker::Unpack(packed.data(), values.size(), bits, unpacked.data());
+    EXPECT_EQ(values, unpacked);
+}
+
+TEST(CompressionTest, FrameOfReferenceSelectMatchesScalar) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int32_t> dist(-5000, -4000);
+    std::vector<int32_t> values(512);
+    for (auto& v : values) v = dist(rng);
+    
+    std::vector<uint8_t> encoded(FrameOfReference::EncodedSize(values.data(), values.size()));
+    FrameOfReference::Encode(values.data(), values.size(), encoded.data());
+    EXPECT_LT(encoded.size(), values.size() * sizeof(int32_t) / 2);
+    
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(FrameOfReference::Get(encoded.data(), i), values[i]);
+    }
+    
+    for (int32_t constant : {-6000, -4500, -4000, 0}) {
+        for (auto op : {CompareOp::EQ, CompareOp::NE, CompareOp::LT,
+                        CompareOp::LE, CompareOp::GT, CompareOp::GE}) {
+            std::vector<uint32_t> expected;
+            for (uint32_t i = 0; i < values.size(); ++i) {
+                int32_t v = values[i];
+                bool match = op == CompareOp::EQ ? v == constant :
+                             op == CompareOp::NE ? v != constant :
+                             op == CompareOp::LT ? v < constant :
+                             op == CompareOp::LE ? v <= constant :
+                             op == CompareOp::GT ? v > constant : v >= constant;
+                if (match) expected.push_back(100 + i);
+            }
+            std::vector<uint32_t> selection;
+            FrameOfReference::Select(encoded.data(), op, constant, 100, &selection);
+            EXPECT_EQ(selection, expected);
+        }
+    }
+}
+
+TEST(CompressionTest, RunLengthEncode) {
+    std::vector<int32_t> values = {1, 1, 1, 2, 2, 7, 7, 7, 7};
+    auto runs = RunLengthEncoding::Encode(values.data(), values.size());
+    ASSERT_EQ(runs.size(), 3u);
+    EXPECT_EQ(runs[2].value, 7);
+    EXPECT_EQ(runs[2].length, 4u);
+    EXPECT_EQ(RunLengthEncoding::CountRuns(values.data(), values.size()), 3u);
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include "storage/disk_manager.h"
+#include <cstring>
+#include <vector>
+
+using namespace mokshith;
+
+class DiskManagerTest : public ::testing::TestWithParam<IOBackendType> {
+protected:
+    void SetUp() override {
+        disk_manager_ = new DiskManager("disk_test.db", GetParam());
+    }
+    
+    void TearDown() override {
+        delete disk_manager_;
+        std::remove("disk_test.db");
+    }
+    
+    DiskManager* disk_manager_;
+};
+
+TEST_P(DiskManagerTest, AsyncWriteThenRead) {
+    const size_t num_pages = 32;
+    // O_DIRECT under io_uring needs page-aligned buffers
+    AlignedPageBuffer out = AllocateAlignedPages(num_pages);
+    AlignedPageBuffer in = AllocateAlignedPages(num_pages);
+    memset(out.get(), 0, num_pages * PAGE_SIZE);
+    memset(in.get(), 0, num_pages * PAGE_SIZE);
+    
+    for (size_t i = 0; i < num_pages; ++i) {
+        page_id_t page_id = disk_manager_->AllocatePage();
+        snprintf(&out[page_id * PAGE_SIZE], PAGE_SIZE, "page %d", page_id);
+    }
+    
+    int completed = 0;
+    for (size_t i = 0; i < num_pages; ++i) {
+        ASSERT_TRUE(disk_manager_->WritePageAsync(
+            i, out.get() + i * PAGE_SIZE,
+            [&completed](page_id_t, int result) {
+                EXPECT_EQ(result, 0);
+                ++completed;
+            }));
+    }
+    disk_manager_->SubmitIO();
+    disk_manager_->DrainIO();
+    EXPECT_EQ(completed, static_cast<int>(num_pages));
+    
+    for (size_t i = 0; i < num_pages; ++i) {
+        ASSERT_TRUE(disk_manager_->ReadPageAsync(i, in.get() + i * PAGE_SIZE, nullptr));
+    }
+    disk_manager_->SubmitIO();
+    disk_manager_->DrainIO();
+    EXPECT_EQ(memcmp(out.get(), in.get(), num_pages * PAGE_SIZE), 0);
+    
+    IOStats stats = disk_manager_->GetIOStats();
+    EXPECT_EQ(stats.num_writes, num_pages);
+    EXPECT_EQ(stats.num_reads, num_pages);
+    EXPECT_EQ(stats.num_completions, 2 * num_pages);
+    EXPECT_GE(stats.max_in_flight, 1u);
+}
+
+TEST_P(DiskManagerTest, SyncAndAsyncAgree) {
+    alignas(PAGE_SIZE) char out[PAGE_SIZE] = "synchronous write";
+    alignas(PAGE_SIZE) char in[PAGE_SIZE] = {0};
+    
+    page_id_t page_id = disk_manager_->AllocatePage();
+    disk_manager_->WritePage(page_id, out);
+    disk_manager_->ReadPageAsync(page_id, in, nullptr);
+    disk_manager_->SubmitIO();
+    disk_manager_->DrainIO();
+    
+    EXPECT_STREQ(in, "synchronous write");
+    EXPECT_EQ(disk_manager_->GetNumWrites(), 1u);
+}
+
+// IO_URING silently falls back to fstream when liburing is unavailable
+INSTANTIATE_TEST_SUITE_P(Backends, DiskManagerTest,
+                         ::testing::Values(IOBackendType::FSTREAM,
+                                           IOBackendType::IO_URING));
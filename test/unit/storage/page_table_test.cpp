@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "storage/page_table.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace mokshith;
+
+TEST(ConcurrentPageTableTest, InsertFindErase) {
+    ConcurrentPageTable table(100);
+    EXPECT_GE(table.Capacity(), 200u);
+    
+    for (page_id_t page_id = 0; page_id < 100; ++page_id) {
+        ASSERT_TRUE(table.Insert(page_id, page_id + 1000));
+    }
+    EXPECT_FALSE(table.Insert(5, 1));
+    for (page_id_t page_id = 0; page_id < 100; ++page_id) {
+        EXPECT_EQ(table.Find(page_id), page_id + 1000);
+    }
+    EXPECT_EQ(table.Find(100), ConcurrentPageTable::NOT_FOUND);
+    
+    for (page_id_t page_id = 0; page_id < 100; page_id += 2) {
+        ASSERT_TRUE(table.Erase(page_id));
+    }
+    EXPECT_FALSE(table.Erase(0));
+    for (page_id_t page_id = 0; page_id < 100; ++page_id) {
+        EXPECT_EQ(table.Find(page_id), page_id % 2 ? page_id + 1000 : ConcurrentPageTable::NOT_FOUND);
+    }
+}
+
+// Churn far more distinct pages through the table than it has slots:
+// tombstones must be reused or reclaimed, not accumulate
+TEST(ConcurrentPageTableTest, ChurnDoesNotFillWithTombstones) {
+    ConcurrentPageTable table(64);
+    for (page_id_t page_id = 0; page_id < 100000; ++page_id) {
+        ASSERT_TRUE(table.Insert(page_id, page_id % 64));
+        if (page_id >= 64) {
+            ASSERT_TRUE(table.Erase(page_id - 64));
+        }
+    }
+    for (page_id_t page_id = 100000 - 64; page_id < 100000; ++page_id) {
+        EXPECT_EQ(table.Find(page_id), page_id % 64);
+    }
+    EXPECT_EQ(table.Find(0), ConcurrentPageTable::NOT_FOUND);
+}
+
+// One writer (the shard latch holder) remaps pages while readers look up
+// resident pages without a latch; readers must never see a frame that
+// was not mapped to their page
+TEST(ConcurrentPageTableTest, LatchFreeReadersDuringWrites) {
+    const page_id_t stable_pages = 256;
+    ConcurrentPageTable table(1024);
+    for (page_id_t page_id = 0; page_id < stable_pages; ++page_id) {
+        table.Insert(page_id, page_id);
+    }
+    
+    std::atomic<bool> stop{false};
+    std::atomic<int> wrong{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([&, r]() {
+            page_id_t page_id = r;
+            while (!stop.load()) {
+                page_id = (page_id + 7) % stable_pages;
+                if (table.Find(page_id) != page_id) ++wrong;
+                // Volatile pages may be found or not, but never wrongly
+                frame_id_t frame = table.Find(stable_pages + page_id);
+                if (frame != ConcurrentPageTable::NOT_FOUND && frame != page_id + 5000) ++wrong;
+            }
+        });
+    }
+    for (int round = 0; round < 200; ++round) {
+        for (page_id_t page_id = 0; page_id < stable_pages; ++page_id) {
+            table.Insert(stable_pages + page_id, page_id + 5000);
+        }
+        for (page_id_t page_id = 0; page_id < stable_pages; ++page_id) {
+            table.Erase(stable_pages + page_id);
+        }
+    }
+    stop = true;
+    for (auto& reader : readers) reader.join();
+    
+    EXPECT_EQ(wrong.load(), 0);
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include "transaction/lock_manager.h"
+#include <thread>
+
+using namespace mokshith;
+
+namespace {
+
+const uint32_t TABLE_OID = 7;
+
+size_t CountRowLocks(Transaction* txn, uint32_t table_oid) {
+    size_t rows = 0;
+    for (const auto& held : txn->GetHeldLocks()) {
+        if (held.first.granularity == LockGranularity::ROW && held.first.table_oid == table_oid) {
+            ++rows;
+        }
+    }
+    return rows;
+}
+
+LockMode TableLockMode(Transaction* txn, uint32_t table_oid) {
+    return txn->GetHeldLocks().at(LockResource::Table(table_oid));
+}
+
+} // namespace
+
+TEST(LockManagerTest, SharedRowLocksEscalateToTableS) {
+    LockManager lock_manager;
+    lock_manager.SetEscalationThreshold(16);
+    Transaction txn(1);
+    
+    for (uint32_t slot = 0; slot < 16; ++slot) {
+        ASSERT_TRUE(lock_manager.LockShared(&txn, TABLE_OID, RID(1, slot)));
+    }
+    EXPECT_EQ(CountRowLocks(&txn, TABLE_OID), 16u);
+    EXPECT_EQ(TableLockMode(&txn, TABLE_OID), LockMode::INTENTION_SHARED);
+    EXPECT_EQ(lock_manager.GetStats().escalations, 0u);
+    
+    // Crossing the threshold trades the row locks for one table lock
+    ASSERT_TRUE(lock_manager.LockShared(&txn, TABLE_OID, RID(1, 16)));
+    EXPECT_EQ(lock_manager.GetStats().escalations, 1u);
+    EXPECT_EQ(TableLockMode(&txn, TABLE_OID), LockMode::SHARED);
+    EXPECT_EQ(CountRowLocks(&txn, TABLE_OID), 0u);
+    EXPECT_EQ(txn.RowLockCount(TABLE_OID), 0u);
+    
+    // Later rows are covered by the table lock and never queue
+    uint64_t covered = lock_manager.GetStats().covered;
+    for (uint32_t slot = 100; slot < 110; ++slot) {
+        ASSERT_TRUE(lock_manager.LockShared(&txn, TABLE_OID, RID(2, slot)));
+    }
+    EXPECT_EQ(lock_manager.GetStats().covered, covered + 10);
+    EXPECT_EQ(CountRowLocks(&txn, TABLE_OID), 0u);
+    
+    // S on the table still admits other readers
+    Transaction reader(2);
+    EXPECT_TRUE(lock_manager.LockTable(&reader, TABLE_OID, LockMode::INTENTION_SHARED));
+    
+    lock_manager.UnlockAll(&reader);
+    lock_manager.UnlockAll(&txn);
+    EXPECT_TRUE(txn.GetHeldLocks().empty());
+}
+
+TEST(LockManagerTest, ExclusiveRowLocksEscalateToTableX) {
+    LockManager lock_manager;
+    lock_manager.SetEscalationThreshold(4);
+    Transaction txn(1);
+    
+    ASSERT_TRUE(lock_manager.LockShared(&txn, TABLE_OID, RID(1, 0)));
+    for (uint32_t slot = 1; slot <= 4; ++slot) {
+        ASSERT_TRUE(lock_manager.LockExclusive(&txn, TABLE_OID, RID(1, slot)));
+    }
+    EXPECT_EQ(lock_manager.GetStats().escalations, 1u);
+    EXPECT_EQ(TableLockMode(&txn, TABLE_OID), LockMode::EXCLUSIVE);
+    EXPECT_EQ(CountRowLocks(&txn, TABLE_OID), 0u);
+    
+    // X covers both shared and exclusive row requests
+    uint64_t covered = lock_manager.GetStats().covered;
+    EXPECT_TRUE(lock_manager.LockShared(&txn, TABLE_OID, RID(3, 0)));
+    EXPECT_TRUE(lock_manager.LockExclusive(&txn, TABLE_OID, RID(3, 1)));
+    EXPECT_EQ(lock_manager.GetStats().covered, covered + 2);
+    
+    // Row locks on other tables are unaffected
+    EXPECT_TRUE(lock_manager.LockShared(&txn, TABLE_OID + 1, RID(9, 0)));
+    EXPECT_EQ(CountRowLocks(&txn, TABLE_OID + 1), 1u);
+    
+    lock_manager.UnlockAll(&txn);
+}
+
+TEST(LockManagerTest, DeadlockAbortsYoungestTransaction) {
+    LockManager lock_manager;
+    Transaction older(1);
+    Transaction younger(2);
+    ASSERT_TRUE(lock_manager.LockExclusive(&older, TABLE_OID, RID(1, 0)));
+    ASSERT_TRUE(lock_manager.LockExclusive(&younger, TABLE_OID, RID(1, 1)));
+    
+    // Each waits for the other's row; detection aborts the younger one
+    std::thread waiter([&]() {
+        EXPECT_FALSE(lock_manager.LockExclusive(&younger, TABLE_OID, RID(1, 0)));
+        EXPECT_EQ(younger.GetState(), TransactionState::ABORTED);
+        lock_manager.UnlockAll(&younger);
+    });
+    EXPECT_TRUE(lock_manager.LockExclusive(&older, TABLE_OID, RID(1, 1)));
+    waiter.join();
+    
+    EXPECT_EQ(older.GetState(), TransactionState::GROWING);
+    lock_manager.UnlockAll(&older);
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include "transaction/lock_mode.h"
+#include <unordered_set>
+
+using namespace mokshith;
+
+namespace {
+
+const LockMode ALL_MODES[] = {
+    LockMode::INTENTION_SHARED,
+    LockMode::INTENTION_EXCLUSIVE,
+    LockMode::SHARED,
+    LockMode::SHARED_INTENTION_EXCLUSIVE,
+    LockMode::EXCLUSIVE,
+};
+
+} // namespace
+
+TEST(LockModeTest, CompatibilityIsSymmetric) {
+    for (LockMode a : ALL_MODES) {
+        for (LockMode b : ALL_MODES) {
+            EXPECT_EQ(AreLocksCompatible(a, b), AreLocksCompatible(b, a));
+        }
+    }
+    EXPECT_TRUE(AreLocksCompatible(LockMode::INTENTION_EXCLUSIVE, LockMode::INTENTION_EXCLUSIVE));
+    EXPECT_TRUE(AreLocksCompatible(LockMode::SHARED_INTENTION_EXCLUSIVE, LockMode::INTENTION_SHARED));
+    EXPECT_FALSE(AreLocksCompatible(LockMode::SHARED, LockMode::INTENTION_EXCLUSIVE));
+    EXPECT_FALSE(AreLocksCompatible(LockMode::INTENTION_SHARED, LockMode::EXCLUSIVE));
+}
+
+// A mode that covers another must conflict with at least everything the
+// weaker mode conflicts with
+TEST(LockModeTest, CoveringModesAreStronger) {
+    for (LockMode held : ALL_MODES) {
+        for (LockMode requested : ALL_MODES) {
+            if (!LockCovers(held, requested)) continue;
+            for (LockMode other : ALL_MODES) {
+                if (!AreLocksCompatible(requested, other)) {
+                    EXPECT_FALSE(AreLocksCompatible(held, other));
+                }
+            }
+        }
+    }
+}
+
+TEST(LockModeTest, CombineGivesWeakestCoveringMode) {
+    EXPECT_EQ(CombineLocks(LockMode::SHARED, LockMode::INTENTION_EXCLUSIVE),
+              LockMode::SHARED_INTENTION_EXCLUSIVE);
+    EXPECT_EQ(CombineLocks(LockMode::INTENTION_SHARED, LockMode::SHARED), LockMode::SHARED);
+    EXPECT_EQ(CombineLocks(LockMode::SHARED_INTENTION_EXCLUSIVE, LockMode::EXCLUSIVE),
+              LockMode::EXCLUSIVE);
+    for (LockMode a : ALL_MODES) {
+        for (LockMode b : ALL_MODES) {
+            LockMode combined = CombineLocks(a, b);
+            EXPECT_TRUE(LockCovers(combined, a));
+            EXPECT_TRUE(LockCovers(combined, b));
+        }
+    }
+    EXPECT_EQ(IntentionFor(LockMode::SHARED), LockMode::INTENTION_SHARED);
+    EXPECT_EQ(IntentionFor(LockMode::EXCLUSIVE), LockMode::INTENTION_EXCLUSIVE);
+}
+
+TEST(LockModeTest, ResourcesHashByGranularity) {
+    std::unordered_set<LockResource, LockResourceHash> resources;
+    resources.insert(LockResource::Table(1));
+    resources.insert(LockResource::Page(1, 0));
+    resources.insert(LockResource::Row(1, 0, 0));
+    resources.insert(LockResource::Row(1, 0, 1));
+    resources.insert(LockResource::Row(2, 0, 0));
+    resources.insert(LockResource::Row(1, 0, 0));
+    EXPECT_EQ(resources.size(), 5u);
+    EXPECT_FALSE(LockResource::Table(1) == LockResource::Page(1, INVALID_PAGE_ID));
+}
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include "transaction/log_manager.h"
+#include "storage/page.h"
+#include <cstring>
+#include <vector>
+
+using namespace mokshith;
+
+TEST(LogRecordTest, PageWriteRoundTripRedoUndo) {
+    const uint32_t size = 16;
+    const uint32_t offset = PAGE_HEADER_SIZE + 100;
+    Page page;
+    page.Init(5);
+    std::memset(page.GetData() + offset, 'a', size);
+
+    std::vector<char> storage(sizeof(LogRecord) + 2 * size);
+    auto* record = reinterpret_cast<LogRecord*>(storage.data());
+    record->type = LogRecordType::PAGE_WRITE;
+    record->txn_id = 1;
+    record->lsn = 7;
+    record->prev_lsn = INVALID_LSN;
+    record->page_id = 5;
+    record->write_offset = offset;
+    record->write_size = size;
+    std::memcpy(record->write_data, page.GetData() + offset, size);
+    std::memset(record->write_data + size, 'b', size);
+    ASSERT_EQ(record->GetSize(), storage.size());
+
+    std::vector<char> serialized(record->GetSize());
+    record->SerializeTo(serialized.data());
+    std::vector<char> copy_storage(serialized.size());
+    auto* copy = reinterpret_cast<LogRecord*>(copy_storage.data());
+    copy->DeserializeFrom(serialized.data());
+    EXPECT_EQ(copy->type, LogRecordType::PAGE_WRITE);
+    EXPECT_EQ(copy->page_id, 5);
+    EXPECT_EQ(copy->write_offset, offset);
+    EXPECT_EQ(copy->write_size, size);
+
+    // Redo is idempotent, and neither image touches the PageHeader
+    copy->RedoPageWrite(page.GetData());
+    copy->RedoPageWrite(page.GetData());
+    EXPECT_EQ(page.GetData()[offset], 'b');
+    EXPECT_EQ(page.GetData()[offset + size - 1], 'b');
+    EXPECT_EQ(page.GetData()[offset + size], 0);
+    copy->UndoPageWrite(page.GetData());
+    EXPECT_EQ(page.GetData()[offset], 'a');
+    EXPECT_EQ(reinterpret_cast<const PageHeader*>(page.GetData())->page_id, 5);
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "transaction/mvcc.h"
+#include <string>
+#include <thread>
+
+using namespace mokshith;
+
+namespace {
+
+std::shared_ptr<UndoLog> MakeUndo(timestamp_t ts, const std::string& image, bool is_deleted = false) {
+    auto log = std::make_shared<UndoLog>();
+    log->ts = ts;
+    log->is_deleted = is_deleted;
+    log->image.assign(image.begin(), image.end());
+    return log;
+}
+
+std::string ImageOf(const UndoLog* log) {
+    return log == nullptr ? "<none>" : std::string(log->image.begin(), log->image.end());
+}
+
+} // namespace
+
+TEST(MvccTest, VisibilityOfHeapVersions) {
+    EXPECT_TRUE(IsVersionVisible(5, 5, 1));
+    EXPECT_TRUE(IsVersionVisible(5, 9, 1));
+    EXPECT_FALSE(IsVersionVisible(6, 5, 1));
+    
+    // Uncommitted writes are visible only to their writer
+    timestamp_t marker = TxnTimestamp(42);
+    EXPECT_TRUE(IsUncommitted(marker));
+    EXPECT_TRUE(IsVersionVisible(marker, 0, 42));
+    EXPECT_FALSE(IsVersionVisible(marker, ~timestamp_t(0) >> 2, 43));
+}
+
+TEST(MvccTest, SnapshotsWalkTheUndoChain) {
+    // Tuple inserted at 1 as "a", updated at 3 to "b", updated at 6 to
+    // "c" (in the heap), so the chain holds b@3 -> a@1 -> absent@0
+    VersionStore<int> store;
+    store.Push(7, MakeUndo(0, "", true));
+    store.Push(7, MakeUndo(1, "a"));
+    store.Push(7, MakeUndo(3, "b"));
+    
+    auto head = store.GetHead(7);
+    EXPECT_EQ(ImageOf(FindVisibleVersion(head.get(), 0)), "<none>");
+    EXPECT_EQ(ImageOf(FindVisibleVersion(head.get(), 1)), "a");
+    EXPECT_EQ(ImageOf(FindVisibleVersion(head.get(), 2)), "a");
+    EXPECT_EQ(ImageOf(FindVisibleVersion(head.get(), 5)), "b");
+    
+    // Abort of the update at 3 puts "a" back at the head
+    auto popped = store.Pop(7);
+    EXPECT_EQ(ImageOf(popped.get()), "b");
+    EXPECT_EQ(ImageOf(store.GetHead(7).get()), "a");
+}
+
+TEST(MvccTest, GarbageCollectionKeepsWhatSnapshotsNeed) {
+    VersionStore<int> store;
+    for (int key = 0; key < 100; ++key) {
+        store.Push(key, MakeUndo(1, "v1"));
+        store.Push(key, MakeUndo(4, "v4"));
+        store.Push(key, MakeUndo(8, "v8"));
+    }
+    
+    Watermark watermark(10);
+    watermark.AddReader(5);
+    watermark.AddReader(9);
+    EXPECT_EQ(watermark.Get(), 5u);
+    
+    // Heap version at 12: the reader at 5 still needs v4, not v1
+    size_t freed = store.Collect(watermark.Get(), [](int) { return timestamp_t(12); });
+    EXPECT_EQ(freed, 100u);
+    auto head = store.GetHead(3);
+    EXPECT_EQ(ImageOf(FindVisibleVersion(head.get(), 5)), "v4");
+    EXPECT_EQ(ImageOf(FindVisibleVersion(head.get(), 9)), "v8");
+    
+    // Once every reader is past the heap version, chains disappear
+    watermark.RemoveReader(5);
+    watermark.RemoveReader(9);
+    watermark.UpdateCommitTimestamp(12);
+    freed = store.Collect(watermark.Get(), [](int) { return timestamp_t(12); });
+    EXPECT_EQ(freed, 200u);
+    EXPECT_EQ(store.NumChains(), 0u);
+    
+    // Uncommitted heap versions pin their chain
+    store.Push(1, MakeUndo(12, "v12"));
+    store.Collect(100, [](int) { return TxnTimestamp(77); });
+    EXPECT_EQ(store.NumChains(), 1u);
+}